@@ -34,3 +34,12 @@ int AndJob::run()
 	}
 	return i_gate;
 }
+
+int PRFJob::run()
+{
+	auto& party = ProgramParty::s();
+	for (size_t i = start; i < end; i++)
+		gate.compute_prfs_outputs(&(*in_wires)[2 * i], party.get_id(),
+				(*outputs)[i], gate_id + i);
+	return end - start;
+}
@@ -40,4 +40,30 @@ public:
 	int run();
 };
 
+class PRFJob
+{
+	vector<const Register*>* in_wires;
+	vector<PRFOutputs>* outputs;
+	GarbledGate gate;
+
+public:
+	size_t start, end;
+	gate_id_t gate_id;
+
+	PRFJob() : in_wires(0), outputs(0), gate(0), start(0), end(0), gate_id(0) {}
+
+	void reset(vector<const Register*>& in_wires,
+			vector<PRFOutputs>& outputs, size_t start, size_t end,
+			gate_id_t gate_id)
+	{
+		this->in_wires = &in_wires;
+		this->outputs = &outputs;
+		this->start = start;
+		this->end = end;
+		this->gate_id = gate_id;
+	}
+
+	int run();
+};
+
 #endif /* BMR_ANDJOB_H_ */
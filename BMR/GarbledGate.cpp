@@ -40,23 +40,32 @@ void GarbledGate::compute_prfs_outputs(const Register** in_wires, int my_id,
 {
     int n_parties = CommonParty::get_n_parties();
     init_inputs(g, n_parties);
+    AES_KEY aes_keys[2][2];
     for(int w=0; w<=1; w++) {
         for (int b=0; b<=1; b++) {
             const Key& key = in_wires[w]->key(my_id, b);
-            AES_KEY aes_key;
-            AES_128_Key_Expansion((unsigned char*)&key.r, &aes_key);
+            AES_128_Key_Expansion((unsigned char*)&key.r, &aes_keys[w][b]);
 #ifdef DEBUG
             cout << "using key " << key << endl;
 #endif
-            for (int e=0; e<=1; e++) {
-                for (int j=1; j<= n_parties; j++) {
-                    prf_output[j-1].outputs[w][b][e][0] =
-                            aes_128_encrypt(*(__m128i*)input(e, j), (octet*)aes_key.rd_key);
-#ifdef __PRIME_FIELD__
-                    ((Key*)prf_outputs_index)->adjust();
-#endif
-                }
-            }
+        }
+    }
+
+    // every input is encrypted under all four keys,
+    // two inputs at a time to use eight pipelines
+    const AES_KEY* keys[8];
+    __m128i in[8], out[8];
+    for (int l = 0; l < 8; l++)
+        keys[l] = &aes_keys[(l / 2) % 2][l % 2];
+    for (int k = 0; k < 2 * n_parties; k += 2) {
+        for (int l = 0; l < 8; l++) {
+            int i = k + l / 4;
+            in[l] = *(__m128i*)input(i / n_parties, i % n_parties + 1);
+        }
+        PRF_multi_key<8>(out, in, keys);
+        for (int l = 0; l < 8; l++) {
+            int i = k + l / 4;
+            prf_output[i % n_parties].outputs[(l / 2) % 2][l % 2][i / n_parties][0] = out[l];
         }
     }
 }
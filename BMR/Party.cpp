@@ -742,6 +742,8 @@ ProgramParty::ProgramParty() :
 	threshold = 128;
 	eval_threads = new Worker<AndJob>[N_EVAL_THREADS];
 	and_jobs.resize(N_EVAL_THREADS);
+	prf_threads = new Worker<PRFJob>[N_EVAL_THREADS];
+	prf_jobs.resize(N_EVAL_THREADS);
 }
 
 FakeProgramParty::FakeProgramParty(int argc, const char** argv) :
@@ -788,7 +790,7 @@ FakeProgramParty::FakeProgramParty(int argc, const char** argv) :
 	P = new PlainPlayer(N, 0);
 	if (argc > 4)
 		threshold = atoi(argv[4]);
-	cout << "Threshold for multi-threaded evaluation: " << threshold << endl;
+	cout << "Threshold for multi-threaded garbling and evaluation: " << threshold << endl;
 }
 
 ProgramParty::~ProgramParty()
@@ -800,6 +802,7 @@ ProgramParty::~ProgramParty()
 		delete P;
 	}
 	delete[] eval_threads;
+	delete[] prf_threads;
 #ifdef VERBOSE
 	if (spdz_counters[SPDZ_LOAD])
 	    cerr << "SPDZ loading: " << spdz_counters[SPDZ_LOAD] << endl;
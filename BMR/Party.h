@@ -192,6 +192,9 @@ protected:
 	Worker<AndJob>* eval_threads;
 	vector<AndJob> and_jobs;
 
+	Worker<PRFJob>* prf_threads;
+	vector<PRFJob> prf_jobs;
+
 	ReceivedMsgStore output_masks_store;
 	ReceivedMsgStore input_masks_store;
 
@@ -280,6 +280,13 @@ public:
 	static void load(vector<GC::ReadAccess<T> >& accesses,
 			const NoMemory& source);
 
+	template <class T>
+	static void andrs(T& processor, const vector<int>& args) { and_(processor, args, true); }
+	template <class T>
+	static void ands(T& processor, const vector<int>& args) { and_(processor, args, false); }
+	template <class T>
+	static void and_(T& processor, const vector<int>& args, bool repeat);
+
 	PRFRegister(const Register& reg) : ProgramRegister(reg) {}
 
 	void op(const PRFRegister& left, const PRFRegister& right, Function func);
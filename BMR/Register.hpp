@@ -22,6 +22,62 @@ void PRFRegister::load(vector<GC::ReadAccess<T> >& accesses,
         }
 }
 
+template <class T>
+void PRFRegister::and_(T& processor, const vector<int>& args, bool repeat)
+{
+    ProgramParty& party = ProgramParty::s();
+    processor.check_args(args, 4);
+
+    // keys and gate numbers have to be drawn in order
+    vector<PRFRegister*> out_wires;
+    vector<const Register*> in_wires;
+    gate_id_t first_gate = 0;
+    for (size_t j = 0; j < args.size(); j += 4)
+    {
+        auto& dest = processor.S[args[j + 1]];
+        dest.resize_regs(args[j]);
+        processor.complexity += args[j];
+        for (int i = 0; i < args[j]; i++)
+        {
+            auto& out = dest.get_reg(i);
+            party.receive_keys(out);
+            gate_id_t gate_id = party.new_gate();
+            if (out_wires.empty())
+                first_gate = gate_id;
+            out_wires.push_back(&out);
+            in_wires.push_back(&processor.S[args[j + 2]].get_reg(i));
+            in_wires.push_back(&processor.S[args[j + 3]].get_reg(repeat ? 0 : i));
+        }
+    }
+
+    // the PRF outputs of a layer are independent
+    size_t total = out_wires.size();
+    vector<PRFOutputs> prf_outputs;
+    prf_outputs.reserve(total);
+    for (size_t i = 0; i < total; i++)
+        prf_outputs.emplace_back(party.get_n_parties());
+    int n_threads = (int)total < party.threshold ? 1 : N_EVAL_THREADS;
+    size_t gates_per_thread = (total + n_threads - 1) / n_threads;
+    for (int i = 0; i < n_threads; i++)
+        party.prf_jobs[i].reset(in_wires, prf_outputs,
+                min(total, i * gates_per_thread),
+                min(total, (i + 1) * gates_per_thread), first_gate);
+    if (n_threads == 1)
+        party.prf_jobs[0].run();
+    else
+    {
+        for (int i = 0; i < n_threads; i++)
+            party.prf_threads[i].request(party.prf_jobs[i]);
+        for (int i = 0; i < n_threads; i++)
+            party.prf_threads[i].done();
+    }
+
+    for (size_t i = 0; i < total; i++)
+        party.process_prf_output(prf_outputs[i], out_wires[i],
+                static_cast<const PRFRegister*>(in_wires[2 * i]),
+                static_cast<const PRFRegister*>(in_wires[2 * i + 1]));
+}
+
 template <class T>
 void EvalRegister::store_clear_in_dynamic(GC::Memory<T>& mem,
 		const vector<GC::ClearWriteAccess>& accesses)
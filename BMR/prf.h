@@ -26,10 +26,38 @@ inline void PRF_chunk(const Key& key, char* input, char* output, int number)
 		ecb_aes_128_encrypt<3>(out, in, (octet*)aes_key.rd_key);
 		break;
 	default:
-		for (int i = 0; i < number; i++)
+		int i = 0;
+		for (; i + 8 <= number; i += 8)
+			ecb_aes_128_encrypt<8>(&out[i], &in[i], (octet*)aes_key.rd_key);
+		for (; i < number; i++)
 			ecb_aes_128_encrypt<1>(&out[i], &in[i], (octet*)aes_key.rd_key);
 		break;
 	}
 }
 
+/*
+ * Encrypts N blocks, each with its own key, interleaving the rounds
+ * to keep the AES-NI pipeline busy.
+ */
+template <int N>
+inline void PRF_multi_key(__m128i* out, const __m128i* in, const AES_KEY** keys)
+{
+#ifdef __AES__
+	if (cpu_has_aes())
+	{
+		__m128i tmp[N];
+		for (int i = 0; i < N; i++)
+			tmp[i] = _mm_xor_si128(in[i], keys[i]->rd_key[0]);
+		for (int j = 1; j < 10; j++)
+			for (int i = 0; i < N; i++)
+				tmp[i] = _mm_aesenc_si128(tmp[i], keys[i]->rd_key[j]);
+		for (int i = 0; i < N; i++)
+			out[i] = _mm_aesenclast_si128(tmp[i], keys[i]->rd_key[10]);
+	}
+	else
+#endif
+		for (int i = 0; i < N; i++)
+			out[i] = aes_128_encrypt(in[i], (octet*)keys[i]->rd_key);
+}
+
 #endif /* PROTOCOL_INC_PRF_H_ */
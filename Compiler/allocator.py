@@ -384,6 +384,8 @@ class Merger:
         warned_about_mem = []
         last_mem_write_of = defaultdict(list)
         last_mem_read_of = defaultdict(list)
+        last_range_write = defaultdict(list)
+        last_range_read = defaultdict(list)
         last_print_str = None
         last = defaultdict(lambda: defaultdict(lambda: None))
         last_open = deque()
@@ -507,7 +509,18 @@ class Merger:
                 parallel_open[depth] += len(instr.args) * instr.get_size()
                 depths[n] = depth
 
-            if isinstance(instr, ReadMemoryInstruction):
+            if isinstance(instr, matmuls_class):
+                # reads whole matrices, so only order with writes of
+                # the same type instead of starting a new block
+                reg_type = instr.args[0].reg_type
+                write_ns = last_range_write[reg_type]
+                read_ns = last_range_read[reg_type]
+                if write_ns and read_ns and write_ns[-1] > read_ns[-1]:
+                    read_ns[:] = []
+                read_ns.append(n)
+                for i in write_ns:
+                    add_edge(i, n)
+            elif isinstance(instr, ReadMemoryInstruction):
                 if options.preserve_mem_order:
                     if last_mem_write and last_mem_read and last_mem_write[-1] > last_mem_read[-1]:
                         last_mem_read[:] = []
@@ -517,6 +530,14 @@ class Merger:
                 else:
                     mem_access(n, instr, last_mem_read_of, last_mem_write_of)
             elif isinstance(instr, WriteMemoryInstruction):
+                reg_type = instr.args[0].reg_type
+                write_ns = last_range_write[reg_type]
+                read_ns = last_range_read[reg_type]
+                if write_ns and read_ns and write_ns[-1] < read_ns[-1]:
+                    write_ns[:] = []
+                write_ns.append(n)
+                for i in read_ns:
+                    add_edge(i, n)
                 if options.preserve_mem_order:
                     if last_mem_write and last_mem_read and last_mem_write[-1] < last_mem_read[-1]:
                         last_mem_write[:] = []
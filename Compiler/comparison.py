@@ -140,8 +140,7 @@ def TruncLeakyInRing(a, k, m, signed):
     n_bits = k - m
     n_shift = int(program.options.ring) - n_bits
     if program.use_dabit and n_bits > 1:
-        r, r_bits = zip(*(sint.get_dabit() for i in range(n_bits)))
-        r = sint.bit_compose(r)
+        r, r_bits = sint.get_edabit(n_bits)
     else:
         r_bits = [sint.get_random_bit() for i in range(n_bits)]
         r = sint.bit_compose(r_bits)
@@ -200,11 +199,11 @@ def Mod2mRing(a_prime, a, k, m, signed):
     from Compiler.types import sint, intbitint, cint
     shift = int(program.options.ring) - m
     if program.use_dabit:
-        r, r_bin = zip(*(sint.get_dabit() for i in range(m)))
+        r_prime, r_bin = sint.get_edabit(m)
     else:
         r = [sint.get_random_bit() for i in range(m)]
         r_bin = r
-    r_prime = sint.bit_compose(r)
+        r_prime = sint.bit_compose(r)
     tmp = a + r_prime
     c_prime = (tmp << shift).reveal() >> shift
     u = sint()
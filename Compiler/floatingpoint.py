@@ -33,8 +33,7 @@ def shift_two(n, pos):
 def maskRing(a, k):
     shift = int(program.Program.prog.options.ring) - k
     if program.Program.prog.use_dabit:
-        rr, r = zip(*(types.sint.get_dabit() for i in range(k)))
-        r_prime = types.sint.bit_compose(rr)
+        r_prime, r = types.sint.get_edabit(k)
     else:
         r = [types.sint.get_random_bit() for i in range(k)]
         r_prime = types.sint.bit_compose(r)
@@ -300,8 +299,7 @@ def BitDec(a, k, m, kappa, bits_to_compute=None):
 def BitDecRing(a, k, m):
     n_shift = int(program.Program.prog.options.ring) - m
     if program.Program.prog.use_dabit:
-        r, r_bits = zip(*(types.sint.get_dabit() for i in range(m)))
-        r = types.sint.bit_compose(r)
+        r, r_bits = types.sint.get_edabit(m)
     else:
         r_bits = [types.sint.get_random_bit() for i in range(m)]
         r = types.sint.bit_compose(r_bits)
@@ -347,6 +347,11 @@ class use_prep(base.Instruction):
     code = base.opcodes['USE_PREP']
     arg_format = ['str','int']
 
+class use_matmul(base.Instruction):
+    r""" Matrix triple usage. """
+    code = base.opcodes['USE_MATMUL']
+    arg_format = ['int','int','int','int','int']
+
 class nplayers(base.Instruction):
     r""" Number of players """
     code = base.opcodes['NPLAYERS']
@@ -810,6 +815,21 @@ class dabit(base.DataInstruction):
     field_type = 'modp'
     data_type = 'bit'
 
+@base.vectorize
+class edabit(base.DataInstruction):
+    """ edaBit: random value in arithmetic and its bits in binary """
+    __slots__ = []
+    code = base.opcodes['EDABIT']
+    arg_format = tools.chain(['sw'], itertools.repeat('sbw'))
+    field_type = 'modp'
+    data_type = 'bit'
+
+    def has_var_args(self):
+        return True
+
+    def get_repeat(self):
+        return len(self.args) - 1
+
 @base.gf2n
 @base.vectorize
 class square(base.DataInstruction):
@@ -1561,6 +1581,33 @@ class dotprods(base.VarArgsInstruction, base.DataInstruction):
             for reg in self.args[i + 2:i + self.args[i]]:
                 yield reg
 
+@base.gf2n
+class matmuls(base.DataInstruction, base.ReadMemoryInstruction):
+    """ Secret matrix multiplication of two matrices in memory. The result
+    is stored in a register vector in row-major order.
+
+    :param: result (sint vector of size rows times columns)
+    :param: address of first factor (regint)
+    :param: address of second factor (regint)
+    :param: number of rows in first factor (int)
+    :param: number of columns in first factor and rows in second (int)
+    :param: number of columns in second factor (int)
+    """
+    __slots__ = []
+    code = base.opcodes['MATMULS']
+    arg_format = ['sw','ci','ci','int','int','int']
+    data_type = 'triple'
+    is_vec = lambda self: True
+
+    def get_repeat(self):
+        return self.args[3] * self.args[4] * self.args[5]
+
+    def add_usage(self, req_node):
+        # triples are only used if there is no matrix triple
+        base.DataInstruction.add_usage(self, req_node)
+        req_node.increment((self.field_type, 'matmul') + \
+                           tuple(self.args[3:]), 1)
+
 @base.vectorize
 class trunc_pr(base.VarArgsInstruction):
     """ Probalistic truncation for semi-honest computation """
@@ -56,6 +56,7 @@ opcodes = dict(
     USE_PREP = 0x1C,
     STARTGRIND = 0x1D,
     STOPGRIND = 0x1E,
+    USE_MATMUL = 0x1F,
     NPLAYERS = 0xE2,
     THRESHOLD = 0xE3,
     PLAYERID = 0xE4,
@@ -93,6 +94,7 @@ opcodes = dict(
     MULRS = 0xA7,
     DOTPRODS = 0xA8,
     TRUNC_PR = 0xA9,
+    MATMULS = 0xAA,
     # Data access
     TRIPLE = 0x50,
     BIT = 0x51,
@@ -103,6 +105,7 @@ opcodes = dict(
     INPUTMASK = 0x56,
     PREP = 0x57,
     DABIT = 0x58,
+    EDABIT = 0x59,
     # Input
     INPUT = 0x60,
     INPUTFIX = 0xF0,
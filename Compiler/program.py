@@ -700,6 +700,11 @@ class Tape:
                     Compiler.instructions.use_inp(field_types[req[0]], \
                                                       req[2], num, \
                                                       add_to_prog=False))
+            elif req[1] == 'matmul':
+                self.basicblocks[-1].instructions.append(
+                    Compiler.instructions.use_matmul(field_types[req[0]], \
+                                                     *(req[2:] + (num,)), \
+                                                     add_to_prog=False))
             elif req[0] == 'modp':
                 self.basicblocks[-1].instructions.append(
                     Compiler.instructions.use_prep(req[1], num, \
@@ -831,6 +836,9 @@ class Tape:
             return ", ".join('%s inputs in %s from player %d' \
                                 % (num, req[0], req[2]) \
                                 if req[1] == 'input' \
+                                else '%s %dx%dx%d matrix triples in %s' \
+                                % ((num,) + req[2:] + (req[0],)) \
+                                if req[1] == 'matmul' \
                                 else '%s %ss in %s' % (num, req[1], req[0]) \
                                 for req,num in list(self.items()))
         def __repr__(self):
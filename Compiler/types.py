@@ -1480,6 +1480,20 @@ class _secret(_register):
                        for j in range(size)), []))
         return res
 
+    @classmethod
+    @set_instruction_type
+    def direct_matrix_mul(cls, A, B, n, m, l, reduce=None):
+        """ Secret matrix multiplication directly from memory.
+
+        :param A: address of n x m matrix (regint/int)
+        :param B: address of m x l matrix (regint/int)
+        :returns: vector of size n * l in row-major order """
+        A = regint.conv(A)
+        B = regint.conv(B)
+        res = cls(size=n * l)
+        matmuls(res, A, B, n, m, l)
+        return res
+
     @no_doc
     def __init__(self, reg_type, val=None, size=None):
         if isinstance(val, self.clear_type):
@@ -1667,6 +1681,19 @@ class sint(_secret, _int):
         dabit(*res)
         return res
 
+    @vectorized_classmethod
+    def get_edabit(cls, n_bits):
+        """ Random value of :py:obj:`n_bits` bits in arithmetic and its
+        bits in binary circuit according to security model
+
+        :param n_bits: compile-time integer (int)
+        :returns: tuple of value and list of bits """
+        from Compiler.GC.types import sbits
+        res = cls(), [sbits.get_type(get_global_vector_size())()
+                      for i in range(n_bits)]
+        edabit(res[0], *res[1])
+        return res
+
     @staticmethod
     def long_one():
         return 1
@@ -3205,6 +3232,14 @@ class sfix(_fix):
     def unreduced(self, v, other=None, res_params=None, n_summands=1):
         return unreduced_sfix(v, self.k * 2, self.f, self.kappa)
 
+    @classmethod
+    def direct_matrix_mul(cls, A, B, n, m, l, reduce=True):
+        tmp = cls.int_type.direct_matrix_mul(A, B, n, m, l)
+        res = unreduced_sfix._new(tmp)
+        if reduce:
+            res = res.reduce_after_mul()
+        return res
+
     @staticmethod
     def multipliable(v, k, f):
         return cfix(cint.conv(v), k, f)
@@ -4268,6 +4303,9 @@ class SubMultiArray(object):
             try:
                 if max(res_matrix.sizes) > 1000:
                     raise AttributeError()
+                if res_params is None and self.can_direct_mul(other):
+                    res_matrix.assign_vector(self.direct_mul(other))
+                    return res_matrix
                 A = self.get_vector()
                 B = other.get_vector()
                 res_matrix.assign_vector(
@@ -4292,6 +4330,23 @@ class SubMultiArray(object):
         else:
             raise NotImplementedError
 
+    def can_direct_mul(self, other):
+        return hasattr(self.value_type, 'direct_matrix_mul') and \
+            self.value_type == other.value_type and \
+            len(self.sizes) == 2 and len(other.sizes) == 2
+
+    def direct_mul(self, other, reduce=True):
+        """ Matrix multiplication using the matrix multiplication
+        instruction, which reads both factors directly from memory.
+
+        :param self: two-dimensional
+        :param other: two-dimensional container of matching type and size
+        :returns: vector of all entries in row-major order """
+        assert self.sizes[1] == other.sizes[0]
+        return self.value_type.direct_matrix_mul(
+            self.address, other.address, self.sizes[0], *other.sizes,
+            reduce=reduce)
+
     def budget_mul(self, other, n_rows, row, n_columns, column, reduce=True,
                    res=None):
         assert len(self.sizes) == 2
@@ -4323,6 +4378,12 @@ class SubMultiArray(object):
         :param self: two-dimensional
         :param other: two-dimensional container of matching type and size """
         assert other.sizes[0] == self.sizes[1]
+        if self.can_direct_mul(other) and \
+           max(self.sizes[0], other.sizes[1]) <= 1000:
+            if res is None:
+                res = Matrix(self.sizes[0], other.sizes[1], self.value_type)
+            res.assign_vector(self.direct_mul(other))
+            return res
         return self.budget_mul(other, self.sizes[0], lambda x, i: x[i], \
                                other.sizes[1], \
                                lambda x, j: [x[k][j] for k in range(len(x))],
@@ -15,6 +15,8 @@ public:
     bool fewer_rounds;
     bool check_open;
     bool check_beaver_open;
+    string sign_from;
+    int sign_batch;
 
     EcdsaOptions(ez::ezOptionParser& opt, int argc, const char** argv)
     {
@@ -54,11 +56,33 @@ public:
                 "-B", // Flag token.
                 "--no-beaver-open-check" // Flag token.
         );
+        opt.add(
+                "", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Run as signing service for messages read line by line from "
+                        "file or named pipe (required for all parties but "
+                        "only read by party 0)", // Help description.
+                "-s", // Flag token.
+                "--sign-from" // Flag token.
+        );
+        opt.add(
+                "100", // Default.
+                0, // Required?
+                1, // Number of args expected.
+                0, // Delimiter if expecting multiple args.
+                "Maximal number of signatures per round in service mode (default: 100)", // Help description.
+                "-sb", // Flag token.
+                "--sign-batch" // Flag token.
+        );
         opt.parse(argc, argv);
         prep_mul = not opt.isSet("-D");
         fewer_rounds = opt.isSet("-P");
         check_open = not opt.isSet("-C");
         check_beaver_open = not opt.isSet("-B");
+        opt.get("-s")->getString(sign_from);
+        opt.get("-sb")->getInt(sign_batch);
         opt.resetArgs();
     }
 };
@@ -5,69 +5,251 @@
 
 #include "P256Element.h"
 
-#include <cryptopp/oids.h>
-#include <cryptopp/misc.h>
-
-CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> P256Element::params;
-CryptoPP::ECP P256Element::curve;
+P256Element::Field P256Element::b, P256Element::b3;
+vector<P256Element::Table> P256Element::base_table;
 
 void P256Element::init()
 {
-    params = CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP>(CryptoPP::ASN1::secp256k1());
-    curve = params.GetCurve();
-    auto mod = params.GetSubgroupOrder();
-    Scalar::init_field(CryptoPP::IntToString(mod).c_str(), false);
+    Scalar::init_field(
+            bigint(
+                    "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141"),
+            false);
+
+    uint64_t seven[4] = { 7, 0, 0, 0 };
+    b = Field::from_words(seven);
+    b3 = b + b + b;
+
+    P256Element G;
+    G.X = Field::from_bigint(
+            bigint(
+                    "0x79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798"));
+    G.Y = Field::from_bigint(
+            bigint(
+                    "0x483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8"));
+    G.Z = Field::one();
+
+    vector<P256Element> points;
+    for (int i = 0; i < 64; i++)
+    {
+        P256Element multiple;
+        for (int j = 0; j < 16; j++)
+        {
+            points.push_back(multiple);
+            multiple += G;
+        }
+        for (int j = 0; j < 4; j++)
+            G = G.dbl();
+    }
+    normalize(points);
+
+    base_table.resize(64);
+    for (int i = 0; i < 64; i++)
+        for (int j = 0; j < 16; j++)
+            base_table[i][j] = points[16 * i + j];
+}
+
+void P256Element::get_nibbles(unsigned char* nibbles, const Scalar& other)
+{
+    // the scalar field is initialized without Montgomery representation
+    unsigned char bytes[32];
+    assert(other.size() == 32);
+    memcpy(bytes, other.get_ptr(), 32);
+    for (int i = 0; i < 32; i++)
+    {
+        nibbles[2 * i] = bytes[i] & 15;
+        nibbles[2 * i + 1] = bytes[i] >> 4;
+    }
+}
+
+P256Element P256Element::select(const Table& table, int index)
+{
+    P256Element res;
+    for (int j = 0; j < 16; j++)
+    {
+        uint64_t diff = j ^ index;
+        uint64_t flag = ((diff | -diff) >> 63) ^ 1;
+        res.X.conditional_assign(table[j].X, flag);
+        res.Y.conditional_assign(table[j].Y, flag);
+        res.Z.conditional_assign(table[j].Z, flag);
+    }
+    return res;
+}
+
+P256Element::P256Element() :
+        Y(Field::one())
+{
 }
 
-CryptoPP::Integer P256Element::convert(const Scalar& other)
+P256Element::P256Element(const Scalar& other) :
+        P256Element()
 {
-    return CryptoPP::Integer((unsigned char*) other.get_ptr(), other.size(),
-            CryptoPP::Integer::UNSIGNED, CryptoPP::LITTLE_ENDIAN_ORDER);
+    unsigned char nibbles[64];
+    get_nibbles(nibbles, other);
+    for (int i = 0; i < 64; i++)
+        *this += select(base_table[i], nibbles[i]);
 }
 
-P256Element::P256Element()
+P256Element::P256Element(word other) :
+        P256Element(Scalar(bigint(other)))
 {
-    point = curve.Identity();
 }
 
-P256Element::P256Element(const Scalar& other)
+void P256Element::check() const
 {
-    point = params.ExponentiateBase(convert(other));
+    // Y^2 Z = X^3 + b Z^3
+    if (Y.sqr() * Z != X.sqr() * X + b * Z.sqr() * Z)
+        throw runtime_error("point not on curve");
 }
 
-P256Element::P256Element(word other)
+void P256Element::normalize(vector<P256Element>& points)
 {
-    point = params.ExponentiateBase(other);
+    vector<Field> prefixes;
+    prefixes.reserve(points.size());
+    Field acc = Field::one();
+    for (auto& point : points)
+    {
+        prefixes.push_back(acc);
+        if (not point.is_identity())
+            acc *= point.Z;
+    }
+    Field inv = acc.invert();
+    for (size_t i = points.size(); i-- > 0;)
+    {
+        auto& point = points[i];
+        if (point.is_identity())
+        {
+            point = {};
+            continue;
+        }
+        Field z_inv = inv * prefixes[i];
+        inv *= point.Z;
+        point.X *= z_inv;
+        point.Y *= z_inv;
+        point.Z = Field::one();
+    }
 }
 
-void P256Element::check()
+void P256Element::normalize()
 {
-    curve.VerifyPoint(point);
+    if (is_identity())
+        *this = {};
+    else if (Z != Field::one())
+    {
+        Field z_inv = Z.invert();
+        X *= z_inv;
+        Y *= z_inv;
+        Z = Field::one();
+    }
+}
+
+void P256Element::get_affine(Field& x, Field& y) const
+{
+    P256Element tmp = *this;
+    tmp.normalize();
+    x = tmp.X;
+    y = tmp.Y;
 }
 
 P256Element::Scalar P256Element::x() const
 {
-    return bigint(IntToString(point.x));
+    Field x, y;
+    get_affine(x, y);
+    return x.to_bigint();
 }
 
-P256Element P256Element::operator +(const P256Element& other) const
+P256Element P256Element::dbl() const
 {
+    // Algorithm 9 of Renes et al. for a = 0
     P256Element res;
-    res.point = curve.Add(point, other.point);
+    Field t0, t1, t2;
+    t0 = Y.sqr();
+    res.Z = t0 + t0;
+    res.Z += res.Z;
+    res.Z += res.Z;
+    t1 = Y * Z;
+    t2 = Z.sqr();
+    t2 = b3 * t2;
+    res.X = t2 * res.Z;
+    res.Y = t0 + t2;
+    res.Z = t1 * res.Z;
+    t1 = t2 + t2;
+    t2 = t1 + t2;
+    t0 = t0 - t2;
+    res.Y = t0 * res.Y;
+    res.Y = res.X + res.Y;
+    t1 = X * Y;
+    res.X = t0 * t1;
+    res.X = res.X + res.X;
     return res;
 }
 
-P256Element P256Element::operator -(const P256Element& other) const
+P256Element P256Element::operator +(const P256Element& other) const
 {
+    // Algorithm 7 of Renes et al. for a = 0
     P256Element res;
-    res.point = curve.Add(point, curve.Inverse(other.point));
+    auto& X3 = res.X;
+    auto& Y3 = res.Y;
+    auto& Z3 = res.Z;
+    Field t0, t1, t2, t3, t4;
+    t0 = X * other.X;
+    t1 = Y * other.Y;
+    t2 = Z * other.Z;
+    t3 = X + Y;
+    t4 = other.X + other.Y;
+    t3 = t3 * t4;
+    t4 = t0 + t1;
+    t3 = t3 - t4;
+    t4 = Y + Z;
+    X3 = other.Y + other.Z;
+    t4 = t4 * X3;
+    X3 = t1 + t2;
+    t4 = t4 - X3;
+    X3 = X + Z;
+    Y3 = other.X + other.Z;
+    X3 = X3 * Y3;
+    Y3 = t0 + t2;
+    Y3 = X3 - Y3;
+    X3 = t0 + t0;
+    t0 = X3 + t0;
+    t2 = b3 * t2;
+    Z3 = t1 + t2;
+    t1 = t1 - t2;
+    Y3 = b3 * Y3;
+    X3 = t4 * Y3;
+    t2 = t3 * t1;
+    X3 = t2 - X3;
+    Y3 = Y3 * t0;
+    t1 = t1 * Z3;
+    Y3 = t1 + Y3;
+    t0 = t0 * t3;
+    Z3 = Z3 * t4;
+    Z3 = Z3 + t0;
     return res;
 }
 
+P256Element P256Element::operator -(const P256Element& other) const
+{
+    P256Element neg = other;
+    neg.Y = Field::zero() - other.Y;
+    return *this + neg;
+}
+
 P256Element P256Element::operator *(const Scalar& other) const
 {
+    Table table;
+    table[1] = *this;
+    for (int j = 2; j < 16; j++)
+        table[j] = table[j - 1] + *this;
+
+    unsigned char nibbles[64];
+    get_nibbles(nibbles, other);
     P256Element res;
-    res.point = curve.Multiply(convert(other), point);
+    for (int i = 63; i >= 0; i--)
+    {
+        for (int j = 0; j < 4; j++)
+            res = res.dbl();
+        res += select(table, nibbles[i]);
+    }
     return res;
 }
 
@@ -87,7 +269,7 @@ P256Element& P256Element::operator /=(const Scalar& other)
 
 bool P256Element::operator ==(const P256Element& other) const
 {
-    return point == other.point;
+    return X * other.Z == other.X * Z and Y * other.Z == other.Y * Z;
 }
 
 bool P256Element::operator !=(const P256Element& other) const
@@ -97,32 +279,42 @@ bool P256Element::operator !=(const P256Element& other) const
 
 void P256Element::pack(octetStream& os) const
 {
-    os.serialize(point.identity);
-    size_t l;
-    l = point.x.MinEncodedSize();
-    os.serialize(l);
-    point.x.Encode(os.append(l), l);
-    l = point.y.MinEncodedSize();
-    os.serialize(l);
-    point.y.Encode(os.append(l), l);
+    // affine coordinates do not leak how the point was computed
+    Field x, y;
+    get_affine(x, y);
+    os.serialize(is_identity());
+    uint64_t words[4];
+    x.to_words(words);
+    os.append((octet*) words, sizeof(words));
+    y.to_words(words);
+    os.append((octet*) words, sizeof(words));
 }
 
 void P256Element::unpack(octetStream& os)
 {
-    os.unserialize(point.identity);
-    size_t l;
-    os.unserialize(l);
-    point.x.Decode(os.consume(l), l);
-    os.unserialize(l);
-    point.y.Decode(os.consume(l), l);
+    bool identity;
+    os.unserialize(identity);
+    uint64_t words[4];
+    os.consume((octet*) words, sizeof(words));
+    X = Field::from_words(words);
+    os.consume((octet*) words, sizeof(words));
+    Y = Field::from_words(words);
+    if (identity)
+        *this = {};
+    else
+        Z = Field::one();
+    check();
 }
 
 ostream& operator <<(ostream& s, const P256Element& x)
 {
-    auto& point = x.get();
-    if (point.identity)
+    if (x.is_identity())
         s << "ID" << endl;
     else
-        s << point.x << "," << point.y;
+    {
+        P256Element::Field a, b;
+        x.get_affine(a, b);
+        s << a.to_bigint() << "," << b.to_bigint();
+    }
     return s;
 }
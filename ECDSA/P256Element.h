@@ -6,22 +6,37 @@
 #ifndef ECDSA_P256ELEMENT_H_
 #define ECDSA_P256ELEMENT_H_
 
-#include <cryptopp/eccrypto.h>
-
 #include "Math/gfp.h"
+#include "P256Field.h"
+
+#include <array>
 
+/*
+ * Points on secp256k1 in homogeneous projective coordinates using the
+ * complete formulas by Renes, Costello, and Batina. Scalar
+ * multiplication uses constant-time table lookups, with precomputed
+ * tables for the generator.
+ */
 class P256Element : public ValueInterface
 {
 public:
     typedef gfp_<2, 4> Scalar;
+    typedef P256Field Field;
 
 private:
-    static CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> params;
-    static CryptoPP::ECP curve;
+    typedef array<P256Element, 16> Table;
 
-    CryptoPP::ECP::Point point;
+    static Field b, b3;
+    // j * 16^i * G in row i
+    static vector<Table> base_table;
 
-    static CryptoPP::Integer convert(const Scalar& other);
+    // identity is (0 : 1 : 0)
+    Field X, Y, Z;
+
+    static void get_nibbles(unsigned char* nibbles, const Scalar& other);
+    static P256Element select(const Table& table, int index);
+
+    P256Element dbl() const;
 
 public:
     typedef void next;
@@ -36,10 +51,14 @@ public:
     P256Element(const Scalar& other);
     P256Element(word other);
 
-    void check();
+    void check() const;
+
+    // normalize all at once using Montgomery's trick
+    static void normalize(vector<P256Element>& points);
+    void normalize();
 
-    const CryptoPP::ECP::Point& get() const { return point; }
-//    const unsigned char* get() const { return a; }
+    void get_affine(Field& x, Field& y) const;
+    bool is_identity() const { return Z.is_zero(); }
 
     Scalar x() const;
 
@@ -54,7 +73,7 @@ public:
     bool operator!=(const P256Element& other) const;
 
     void assign_zero() { *this = 0; }
-    bool is_zero() { return *this == 0; }
+    bool is_zero() { return is_identity(); }
     void add(const P256Element& x, const P256Element& y) { *this = x + y; }
     void sub(const P256Element& x, const P256Element& y) { *this = x - y; }
     void mul(const P256Element& x, const Scalar& y) { *this = x * y; }
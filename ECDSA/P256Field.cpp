@@ -0,0 +1,60 @@
+/*
+ * P256Field.cpp
+ *
+ */
+
+#include "P256Field.h"
+
+const uint64_t P256Field::p[4] = { 0xfffffffefffffc2f, 0xffffffffffffffff,
+        0xffffffffffffffff, 0xffffffffffffffff };
+
+P256Field P256Field::one()
+{
+    P256Field res;
+    res.a[0] = 1;
+    return res;
+}
+
+P256Field P256Field::from_words(const uint64_t* words)
+{
+    P256Field res;
+    reduce_once(res.a, words, 0);
+    return res;
+}
+
+P256Field P256Field::from_bigint(const bigint& x)
+{
+    uint64_t words[4] = { 0, 0, 0, 0 };
+    bigint tmp = x % bigint(mpz_class(1) << 256);
+    mpz_export(words, 0, -1, sizeof(uint64_t), 0, 0, tmp.get_mpz_t());
+    return from_words(words);
+}
+
+void P256Field::to_words(uint64_t* words) const
+{
+    for (int i = 0; i < 4; i++)
+        words[i] = a[i];
+}
+
+bigint P256Field::to_bigint() const
+{
+    uint64_t words[4];
+    to_words(words);
+    bigint res;
+    mpz_import(res.get_mpz_t(), 4, -1, sizeof(uint64_t), 0, 0, words);
+    return res;
+}
+
+P256Field P256Field::invert() const
+{
+    // Fermat with exponent p - 2, which is public
+    uint64_t e[4] = { p[0] - 2, p[1], p[2], p[3] };
+    P256Field res = one();
+    for (int i = 255; i >= 0; i--)
+    {
+        res = res.sqr();
+        if ((e[i / 64] >> (i % 64)) & 1)
+            res *= *this;
+    }
+    return res;
+}
@@ -0,0 +1,162 @@
+/*
+ * P256Field.h
+ *
+ */
+
+#ifndef ECDSA_P256FIELD_H_
+#define ECDSA_P256FIELD_H_
+
+#include <stdint.h>
+
+#include "Math/bigint.h"
+
+/*
+ * Coordinate field of the curve used by P256Element (secp256k1) with
+ * four 64-bit limbs. The prime has the form 2^256 - c for a small c,
+ * which allows a faster reduction than Montgomery's.
+ * All operations except inversion are constant-time.
+ */
+class P256Field
+{
+    typedef unsigned __int128 dword;
+
+    static const uint64_t p[4];
+    static const uint64_t c = 0x1000003d1;
+
+    uint64_t a[4];
+
+    // returns x - p if that is non-negative, otherwise x (with carry c)
+    static void reduce_once(uint64_t* res, const uint64_t* x, uint64_t carry)
+    {
+        uint64_t d[4];
+        uint64_t borrow = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            dword t = (dword) x[i] - p[i] - borrow;
+            d[i] = t;
+            borrow = (t >> 64) & 1;
+        }
+        uint64_t mask = -(carry | (borrow ^ 1));
+        for (int i = 0; i < 4; i++)
+            res[i] = (d[i] & mask) | (x[i] & ~mask);
+    }
+
+public:
+    static P256Field zero() { return {}; }
+    static P256Field one();
+    static P256Field from_words(const uint64_t* words);
+    static P256Field from_bigint(const bigint& x);
+
+    P256Field() : a{0, 0, 0, 0} {}
+
+    void to_words(uint64_t* words) const;
+    bigint to_bigint() const;
+
+    bool is_zero() const { return (a[0] | a[1] | a[2] | a[3]) == 0; }
+    bool operator==(const P256Field& other) const
+    {
+        return ((a[0] ^ other.a[0]) | (a[1] ^ other.a[1])
+                | (a[2] ^ other.a[2]) | (a[3] ^ other.a[3])) == 0;
+    }
+    bool operator!=(const P256Field& other) const { return not (*this == other); }
+
+    P256Field operator+(const P256Field& other) const
+    {
+        P256Field res;
+        uint64_t s[4], carry = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            dword t = (dword) a[i] + other.a[i] + carry;
+            s[i] = t;
+            carry = t >> 64;
+        }
+        reduce_once(res.a, s, carry);
+        return res;
+    }
+
+    P256Field operator-(const P256Field& other) const
+    {
+        P256Field res;
+        uint64_t borrow = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            dword t = (dword) a[i] - other.a[i] - borrow;
+            res.a[i] = t;
+            borrow = (t >> 64) & 1;
+        }
+        uint64_t mask = -borrow, carry = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            dword t = (dword) res.a[i] + (p[i] & mask) + carry;
+            res.a[i] = t;
+            carry = t >> 64;
+        }
+        return res;
+    }
+
+    P256Field operator*(const P256Field& other) const
+    {
+        uint64_t t[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        for (int i = 0; i < 4; i++)
+        {
+            uint64_t carry = 0;
+            for (int j = 0; j < 4; j++)
+            {
+                dword x = (dword) a[i] * other.a[j] + t[i + j] + carry;
+                t[i + j] = x;
+                carry = x >> 64;
+            }
+            t[i + 4] = carry;
+        }
+
+        // 2^256 = c modulo p, fold twice
+        uint64_t r[4], carry = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            dword x = (dword) t[4 + i] * c + t[i] + carry;
+            r[i] = x;
+            carry = x >> 64;
+        }
+        dword x = (dword) carry * c + r[0];
+        r[0] = x;
+        carry = x >> 64;
+        for (int i = 1; i < 4; i++)
+        {
+            x = (dword) r[i] + carry;
+            r[i] = x;
+            carry = x >> 64;
+        }
+        // the remaining overflow implies that r is small
+        x = (dword) r[0] + (c & -carry);
+        r[0] = x;
+        carry = x >> 64;
+        for (int i = 1; i < 4; i++)
+        {
+            x = (dword) r[i] + carry;
+            r[i] = x;
+            carry = x >> 64;
+        }
+
+        P256Field res;
+        reduce_once(res.a, r, 0);
+        return res;
+    }
+
+    P256Field& operator+=(const P256Field& other) { return *this = *this + other; }
+    P256Field& operator-=(const P256Field& other) { return *this = *this - other; }
+    P256Field& operator*=(const P256Field& other) { return *this = *this * other; }
+
+    P256Field sqr() const { return *this * *this; }
+    // inversion by exponentiation, zero maps to zero
+    P256Field invert() const;
+
+    // copies other if flag is one, constant-time
+    void conditional_assign(const P256Field& other, uint64_t flag)
+    {
+        uint64_t mask = -flag;
+        for (int i = 0; i < 4; i++)
+            a[i] = (a[i] & ~mask) | (other.a[i] & mask);
+    }
+};
+
+#endif /* ECDSA_P256FIELD_H_ */
@@ -49,5 +49,8 @@ int main(int argc, const char** argv)
     vector<EcTuple<Share>> tuples;
     preprocessing(tuples, n_tuples, sk, proc, opts);
     check(tuples, sk, keyp, P);
-    sign_benchmark(tuples, sk, MCp, P, opts);
+    if (opts.sign_from.empty())
+        sign_benchmark(tuples, sk, MCp, P, opts);
+    else
+        sign_service(tuples, n_tuples, sk, proc, opts);
 }
@@ -62,7 +62,10 @@ void run(int argc, const char** argv)
     vector<EcTuple<T>> tuples;
     preprocessing(tuples, n_tuples, sk, proc, opts);
 //    check(tuples, sk, {}, P);
-    sign_benchmark(tuples, sk, MCp, P, opts, prep_mul ? 0 : &proc);
+    if (opts.sign_from.empty())
+        sign_benchmark(tuples, sk, MCp, P, opts, prep_mul ? 0 : &proc);
+    else
+        sign_service(tuples, n_tuples, sk, proc, opts);
 
     delete &prep;
 }
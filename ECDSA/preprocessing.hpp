@@ -78,6 +78,7 @@ void preprocessing(vector<EcTuple<T>>& tuples, int buffer_size,
     if (opts.fewer_rounds)
         for (int i = 0; i < buffer_size; i++)
             opened_Rs[i] /= cs_opened[i];
+    P256Element::normalize(opened_Rs);
     if (prep_mul)
         protocol.stop_exchange();
     if (opts.check_open)
@@ -80,6 +80,50 @@ EcSignature sign(const unsigned char* message, size_t length,
     return signature;
 }
 
+/*
+ * Signs several messages at once, consuming one tuple each.
+ * All parties need the same messages, and there is only one round
+ * for the delayed multiplication and one for opening.
+ */
+template<template<class U> class T>
+vector<EcSignature> sign(const vector<string>& messages,
+        const EcTuple<T>* tuples,
+        typename T<P256Element::Scalar>::MAC_Check& MC, Player& P,
+        T<P256Element::Scalar> sk = {},
+        SubProcessor<T<P256Element::Scalar>>* proc = 0)
+{
+    size_t n = messages.size();
+    vector<T<P256Element::Scalar>> prods, to_open;
+    if (proc)
+    {
+        auto& protocol = proc->protocol;
+        protocol.init_mul(proc);
+        for (size_t i = 0; i < n; i++)
+            protocol.prepare_mul(sk, tuples[i].a);
+        protocol.exchange();
+        for (size_t i = 0; i < n; i++)
+            prods.push_back(protocol.finalize_mul());
+    }
+    else
+        for (size_t i = 0; i < n; i++)
+            prods.push_back(tuples[i].b);
+    for (size_t i = 0; i < n; i++)
+        to_open.push_back(
+                tuples[i].a
+                        * hash_to_scalar((unsigned char*) messages[i].data(),
+                                messages[i].size())
+                        + prods[i] * tuples[i].R.x());
+    vector<P256Element::Scalar> opened;
+    MC.POpen(opened, to_open, P);
+    vector<EcSignature> signatures(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        signatures[i].R = tuples[i].R;
+        signatures[i].s = opened[i];
+    }
+    return signatures;
+}
+
 inline
 EcSignature sign(const unsigned char* message, size_t length, P256Element::Scalar sk)
 {
@@ -149,4 +193,105 @@ void sign_benchmark(vector<EcTuple<T>>& tuples, T<P256Element::Scalar> sk,
     }
 }
 
+/*
+ * Party 0 reads messages line by line from opts.sign_from and forwards
+ * everything pending (up to opts.sign_batch) to the others, so that the
+ * whole batch is signed in one round. Tuples are replenished in batches
+ * of n_tuples when running low. Party 0 outputs the public key followed by
+ * one signature (r, s) per line. An empty batch at the end of input
+ * terminates.
+ */
+template<template<class U> class T>
+void sign_service(vector<EcTuple<T>>& tuples, int n_tuples,
+        T<P256Element::Scalar> sk, SubProcessor<T<P256Element::Scalar>>& proc,
+        EcdsaOptions& opts)
+{
+    if (n_tuples < 1)
+        throw runtime_error("need to generate at least one tuple at a time");
+
+    Player& P = proc.P;
+    auto& MCp = proc.MC;
+    typename T<P256Element>::Direct_MC MCc(MCp.get_alphai());
+    P256Element pk = MCc.open(sk, P);
+    MCc.Check(P);
+    if (P.my_num() == 0)
+        cout << "Public key: " << pk << endl;
+
+    ifstream input;
+    if (P.my_num() == 0)
+    {
+        input.open(opts.sign_from);
+        if (input.fail())
+            throw file_error(opts.sign_from);
+    }
+
+    size_t batch_size = max(1, opts.sign_batch);
+    size_t used = 0, n_signed = 0;
+    Timer timer;
+    timer.start();
+    while (true)
+    {
+        vector<string> messages;
+        octetStream os;
+        if (P.my_num() == 0)
+        {
+            string message;
+            // block for the first one, then take what is already there
+            while (messages.size() < batch_size and getline(input, message))
+            {
+                messages.push_back(message);
+                if (input.rdbuf()->in_avail() <= 0)
+                    break;
+            }
+            os.store(messages.size());
+            for (auto& message : messages)
+            {
+                os.store(message.size());
+                os.append((octet*) message.data(), message.size());
+            }
+            P.send_all(os);
+        }
+        else
+        {
+            P.receive_player(0, os);
+            messages.resize(os.get_int(8));
+            for (auto& message : messages)
+            {
+                size_t length = os.get_int(8);
+                message.assign((char*) os.consume(length), length);
+            }
+        }
+
+        if (messages.empty())
+            break;
+
+        if (tuples.size() - used < messages.size())
+        {
+            tuples.erase(tuples.begin(), tuples.begin() + used);
+            used = 0;
+            while (tuples.size() < messages.size())
+                preprocessing(tuples,
+                        max(n_tuples, int(messages.size() - tuples.size())),
+                        sk, proc, opts);
+        }
+
+        auto signatures = sign(messages, &tuples[used], MCp, P, sk,
+                opts.prep_mul ? 0 : &proc);
+        used += messages.size();
+        n_signed += messages.size();
+
+        // signatures must not be released before the check
+        if (opts.check_open)
+            MCp.Check(P);
+
+        if (P.my_num() == 0)
+            for (auto& signature : signatures)
+                cout << bigint(signature.R.x()) << " " << bigint(signature.s)
+                        << endl;
+    }
+
+    cerr << "Signed " << n_signed << " messages in " << timer.elapsed()
+            << " seconds" << endl;
+}
+
 #endif /* ECDSA_SIGN_HPP_ */
@@ -18,7 +18,7 @@ void FFT_Data::assign(const FFT_Data& FFTD)
   b=FFTD.b;
 
   iphi=FFTD.iphi;
-
+  word_ntt=FFTD.word_ntt;
 }
 
 
@@ -48,6 +48,7 @@ void FFT_Data::init(const Ring& Rg,const Zp_Data& PrD)
           to_modp(iphi,Rg.phi_m(),PrD);
           Inv(iphi,iphi,PrD);
         }
+      init_word_ntt();
     }
   else 
     { bigint pr=PrD.pr;
@@ -94,6 +95,19 @@ void FFT_Data::init(const Ring& Rg,const Zp_Data& PrD)
         }
     }
 }
+
+
+void FFT_Data::init_word_ntt()
+{
+  word_ntt.reset();
+  if (twop==0 and phi_m()==m()/2 and Word_NTT::usable(phi_m(),prData))
+    { bigint theta,theta_inv,ip;
+      to_bigint(theta,root[0],prData);
+      to_bigint(theta_inv,root[1],prData);
+      to_bigint(ip,iphi,prData);
+      word_ntt.init(phi_m(),prData,theta,theta_inv,ip);
+    }
+}
     
 
 ostream& operator<<(ostream& s,const FFT_Data& FFTD)
@@ -143,7 +157,9 @@ istream& operator>>(istream& s,FFT_Data& FFTD)
   s >> FFTD.twop;
 
   if (FFTD.twop==0)
-    { s >> ans; to_modp(FFTD.iphi,ans,FFTD.prData); }
+    { s >> ans; to_modp(FFTD.iphi,ans,FFTD.prData);
+      FFTD.init_word_ntt();
+    }
   else if (FFTD.twop>0)
     { FFTD.two_root.resize(2);
 
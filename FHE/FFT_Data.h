@@ -5,6 +5,7 @@
 #include "Math/Zp_Data.h"
 #include "Math/gfp.h"
 #include "FHE/Ring.h"
+#include "FHE/NTT.h"
 
 /* Class for holding modular arithmetic data wrt the ring 
  *
@@ -33,6 +34,11 @@ class FFT_Data
   modp iphi;    // 1/phi_m mod pr
   vector< vector<modp> > powers,powers_i;
 
+  // Native transform for the above if the prime fits in a word
+  Word_NTT word_ntt;
+
+  void init_word_ntt();
+
   public:
   typedef gfp T;
   typedef bigint S;
@@ -71,6 +77,8 @@ class FFT_Data
   modp get_root(int i) const     { return root[i];    }
   modp get_iphi() const          { return iphi;       }
 
+  const Word_NTT& get_word_ntt() const { return word_ntt; }
+
   const Ring& get_R() const      { return R; }
 
   bool operator==(const FFT_Data& other) const { return not (*this != other); }
@@ -0,0 +1,124 @@
+#include "FHE/NTT.h"
+
+bool Word_NTT::usable(int phi_m, const Zp_Data& PrD)
+{
+  return numBits(PrD.pr) <= 62 and phi_m > 0 and (phi_m & (phi_m - 1)) == 0;
+}
+
+
+void Word_NTT::init(int phi_m, const Zp_Data& PrD, const bigint& theta,
+    const bigint& theta_inv, const bigint& iphi)
+{
+  if (not usable(phi_m, PrD))
+    { reset();
+      return;
+    }
+
+  n=phi_m;
+  pr=PrD.pr.get_ui();
+  mp_limb_t root=theta.get_ui(), root_inv=theta_inv.get_ui();
+
+  fwd.resize(n);        fwd_shoup.resize(n);
+  inv.resize(n);        inv_shoup.resize(n);
+  scale.resize(n);      scale_shoup.resize(n);
+
+  for (int s=1; s<n; s*=2)
+    { // Same twiddles as FFT_Iter2 and FFT_Iter for this stage
+      mp_limb_t step=1, step_inv=1;
+      for (int i=0; i<n/(2*s); i++)
+        { step=mul_mod(step,root,pr);
+          step_inv=mul_mod(step_inv,root_inv,pr);
+        }
+      mp_limb_t step2=mul_mod(step,step,pr);
+      mp_limb_t step2_inv=mul_mod(step_inv,step_inv,pr);
+      mp_limb_t w=step, w_inv=1;
+      for (int j=0; j<s; j++)
+        { fwd[s-1+j]=w;
+          inv[s-1+j]=w_inv;
+          w=mul_mod(w,step2,pr);
+          w_inv=mul_mod(w_inv,step2_inv,pr);
+        }
+    }
+
+  mp_limb_t w=iphi.get_ui();
+  for (int i=0; i<n; i++)
+    { scale[i]=w;
+      w=mul_mod(w,root_inv,pr);
+    }
+
+  for (int i=0; i<n; i++)
+    { fwd_shoup[i]=shoup(fwd[i],pr);
+      inv_shoup[i]=shoup(inv[i],pr);
+      scale_shoup[i]=shoup(scale[i],pr);
+    }
+}
+
+
+void Word_NTT::transform(vector<mp_limb_t>& a, const vector<mp_limb_t>& w,
+    const vector<mp_limb_t>& w_shoup) const
+{
+  // Bit-reversal of input
+  for (int i=0, j=0; i<n; i++)
+    { if (j>i)
+        { swap(a[i],a[j]); }
+      int m=n/2;
+      while (m>=1 && j>=m)
+        { j-=m;
+          m/=2;
+        }
+      j+=m;
+    }
+
+  // Inputs and outputs of each butterfly are in [0,4p)
+  mp_limb_t twop=2*pr;
+  for (int s=1; s<n; s*=2)
+    { const mp_limb_t* ws=&w[s-1];
+      const mp_limb_t* ws_shoup=&w_shoup[s-1];
+      for (int k=0; k<n; k+=2*s)
+        { mp_limb_t* x=&a[k];
+          mp_limb_t* y=&a[k+s];
+          for (int j=0; j<s; j++)
+            { mp_limb_t u=x[j];
+              if (u>=twop)
+                { u-=twop; }
+              mp_limb_t q=((__uint128_t) ws_shoup[j]*y[j]) >> 64;
+              mp_limb_t t=ws[j]*y[j]-q*pr;
+              x[j]=u+t;
+              y[j]=u-t+twop;
+            }
+        }
+    }
+}
+
+
+void Word_NTT::forward(vector<modp>& a) const
+{
+  vector<mp_limb_t> x(n);
+  for (int i=0; i<n; i++)
+    { x[i]=a[i].get()[0]; }
+  transform(x,fwd,fwd_shoup);
+  for (int i=0; i<n; i++)
+    { mp_limb_t y=x[i];
+      if (y>=2*pr)
+        { y-=2*pr; }
+      if (y>=pr)
+        { y-=pr; }
+      a[i].assign((char*) &y,1);
+    }
+}
+
+
+void Word_NTT::backward(vector<modp>& a) const
+{
+  vector<mp_limb_t> x(n);
+  for (int i=0; i<n; i++)
+    { x[i]=a[i].get()[0]; }
+  transform(x,inv,inv_shoup);
+  for (int i=0; i<n; i++)
+    { mp_limb_t q=((__uint128_t) scale_shoup[i]*x[i]) >> 64;
+      mp_limb_t y=scale[i]*x[i]-q*pr;
+      if (y>=pr)
+        { y-=pr; }
+      a[i].assign((char*) &y,1);
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef _NTT
+#define _NTT
+
+/* Number theoretic transform for a prime p < 2^62 that fits in one
+ * machine word, used for power of two cyclotomics.
+ *
+ * The butterflies use Harvey's lazy reduction (values stay in [0,4p)
+ * between stages) and Shoup's precomputed quotients for the twiddle
+ * multiplications, so no division or multi-limb arithmetic is needed.
+ *
+ * The transform is linear and all constants are held in standard
+ * representation, so it can be applied directly to the limbs of modp
+ * in Montgomery representation. Results are identical to FFT_Iter2
+ * (forward) and FFT_Iter followed by the scaling in
+ * Ring_Element::change_rep (backward).
+ */
+
+#include <vector>
+using namespace std;
+
+#include "Math/modp.h"
+
+class Word_NTT
+{
+  int n;
+  mp_limb_t pr;
+
+  // Twiddles per stage of half size s start at index s-1
+  vector<mp_limb_t> fwd, fwd_shoup;
+  vector<mp_limb_t> inv, inv_shoup;
+  // 1/phi_m * theta^-i for the backward transform
+  vector<mp_limb_t> scale, scale_shoup;
+
+  static mp_limb_t shoup(mp_limb_t w, mp_limb_t pr)
+    { return (mp_limb_t) (((__uint128_t) w << 64) / pr); }
+
+  static mp_limb_t mul_mod(mp_limb_t x, mp_limb_t y, mp_limb_t pr)
+    { return (mp_limb_t) (((__uint128_t) x * y) % pr); }
+
+  void transform(vector<mp_limb_t>& a, const vector<mp_limb_t>& w,
+      const vector<mp_limb_t>& w_shoup) const;
+
+  public:
+
+  // Returns whether the transform applies to these parameters
+  static bool usable(int phi_m, const Zp_Data& PrD);
+
+  Word_NTT() : n(0), pr(0) { ; }
+
+  /* theta is a primitive 2*phi_m'th root of unity, theta_inv its
+   * inverse and iphi is 1/phi_m, all in standard representation
+   */
+  void init(int phi_m, const Zp_Data& PrD, const bigint& theta,
+      const bigint& theta_inv, const bigint& iphi);
+
+  void reset() { n = 0; }
+  bool active() const { return n > 0; }
+
+  void forward(vector<modp>& a) const;
+  void backward(vector<modp>& a) const;
+};
+
+#endif
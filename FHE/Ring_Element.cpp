@@ -92,6 +92,14 @@ void mul(Ring_Element& ans,const Ring_Element& a,const Ring_Element& b)
       for (int i=0; i<(*ans.FFTD).phi_m(); i++)
         { Mul(ans.element[i],a.element[i],b.element[i],(*a.FFTD).get_prD()); }
     }
+  else if ((*ans.FFTD).get_word_ntt().active())
+    { // Going via the evaluation representation is cheap here
+      Ring_Element aa(a),bb(b);
+      aa.change_rep(evaluation);
+      bb.change_rep(evaluation);
+      mul(ans,aa,bb);
+      ans.change_rep(polynomial);
+    }
   else if ((*ans.FFTD).get_twop()!=0)
     { // This is the case where m is not a power of two
 
@@ -241,7 +249,9 @@ void Ring_Element::change_rep(RepType r)
   if (rep==r) { return; }
   if (r==evaluation)
     { rep=evaluation;
-      if ((*FFTD).get_twop()==0)
+      if ((*FFTD).get_word_ntt().active())
+        { (*FFTD).get_word_ntt().forward(element); }
+      else if ((*FFTD).get_twop()==0)
         { // m a power of two variant
           FFT_Iter2(element,(*FFTD).phi_m(),(*FFTD).get_root(0),(*FFTD).get_prD());
 	}
@@ -255,7 +265,9 @@ void Ring_Element::change_rep(RepType r)
     }
   else
     { rep=polynomial;
-      if ((*FFTD).get_twop()==0)
+      if ((*FFTD).get_word_ntt().active())
+        { (*FFTD).get_word_ntt().backward(element); }
+      else if ((*FFTD).get_twop()==0)
 	{ // m a power of two variant
           modp root2;
           Sqr(root2,(*FFTD).get_root(1),(*FFTD).get_prD());
@@ -0,0 +1,66 @@
+/*
+ * ProofThreads.cpp
+ *
+ */
+
+#include "ProofThreads.h"
+#include "Math/bigint.h"
+
+#include <stdexcept>
+
+int ProofThreads::n_threads = 1;
+
+void ProofThreads::Job::reset(const function<void(int, int)>& func, int begin,
+    int end, int step, int thread)
+{
+  this->func = &func;
+  this->begin = begin;
+  this->end = end;
+  this->step = step;
+  this->thread = thread;
+  error.clear();
+}
+
+int ProofThreads::Job::run()
+{
+  bigint::init_thread();
+  try
+  {
+    for (int i = begin; i < end; i += step)
+      (*func)(i, thread);
+  }
+  catch (exception& e)
+  {
+    error = e.what();
+    return 1;
+  }
+  return 0;
+}
+
+ProofThreads::ProofThreads(int n_threads) :
+    jobs(max(1, n_threads)), workers(0)
+{
+  if (jobs.size() > 1)
+    workers = new Worker<Job>[jobs.size() - 1];
+}
+
+ProofThreads::~ProofThreads()
+{
+  delete[] workers;
+}
+
+void ProofThreads::run(int n, const function<void(int, int)>& func)
+{
+  int n_jobs = min(size(), n);
+  for (int i = 0; i < n_jobs; i++)
+    jobs[i].reset(func, i, n, n_jobs, i);
+  for (int i = 1; i < n_jobs; i++)
+    workers[i - 1].request(jobs[i]);
+  int failed = n_jobs ? jobs[0].run() : 0;
+  for (int i = 1; i < n_jobs; i++)
+    failed |= workers[i - 1].done();
+  if (failed)
+    for (auto& job : jobs)
+      if (not job.error.empty())
+        throw runtime_error(job.error);
+}
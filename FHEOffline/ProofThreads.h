@@ -0,0 +1,57 @@
+/*
+ * ProofThreads.h
+ *
+ */
+
+#ifndef FHEOFFLINE_PROOFTHREADS_H_
+#define FHEOFFLINE_PROOFTHREADS_H_
+
+#include "Tools/time-func.h"
+#include "Tools/Worker.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+using namespace std;
+
+/*
+ * Thread pool for the per-ciphertext work in zero-knowledge proofs.
+ * The calling thread takes part, so one thread means no extra threads.
+ */
+class ProofThreads
+{
+  class Job
+  {
+    const function<void(int, int)>* func;
+    int begin, end, step, thread;
+
+  public:
+    string error;
+
+    Job() : func(0), begin(0), end(0), step(1), thread(0) {}
+
+    void reset(const function<void(int, int)>& func, int begin, int end,
+        int step, int thread);
+    int run();
+  };
+
+  vector<Job> jobs;
+  Worker<Job>* workers;
+
+public:
+  static int n_threads;
+
+  ProofThreads(int n_threads = ProofThreads::n_threads);
+  ProofThreads(const ProofThreads&) = delete;
+  ~ProofThreads();
+
+  int size() const { return jobs.size(); }
+
+  /* Calls func(i, thread) for i in [0,n) where thread is in [0,size())
+   * and no two concurrent calls have the same thread.
+   * Exceptions are rethrown as runtime_error in the calling thread.
+   */
+  void run(int n, const function<void(int, int)>& func);
+};
+
+#endif /* FHEOFFLINE_PROOFTHREADS_H_ */
@@ -40,20 +40,29 @@ void Prover<FD,U>::Stage_1(const Proof& P, octetStream& ciphertexts,
 //  ZZ bd=B_plain/(pr+1);
   PRNG G;
   G.ReSeed();
-  Random_Coins rc(pk.get_params());
-  Ciphertext ciphertext(pk.get_params());
+  // Encrypt in chunks of one ciphertext per thread
+  int n_threads=threads.size();
+  vector<Random_Coins> rc(n_threads, pk.get_params());
+  vector<Ciphertext> ciphertext(n_threads, pk.get_params());
   ciphertexts.store(V);
-  for (int i=0; i<V; i++)
-    {
-//      AE.randomize(Diag,binary);
-//      rd=RandPoly(phim,bd<<1);
-//      y[i]=AE.plaintext()+pr*rd;
-      y[i].randomize(G, P.B_plain_length, Diag, binary);
-      s[i].resize(3, P.phim);
-      s[i].generateUniform(G, P.B_rand_length);
-      rc.assign(s[i][0], s[i][1], s[i][2]);
-      pk.encrypt(ciphertext,y[i],rc);
-      ciphertext.pack(ciphertexts);
+  for (int i0=0; i0<V; i0+=n_threads)
+    { int n=min(n_threads,V-i0);
+      for (int i=i0; i<i0+n; i++)
+        {
+//          AE.randomize(Diag,binary);
+//          rd=RandPoly(phim,bd<<1);
+//          y[i]=AE.plaintext()+pr*rd;
+          y[i].randomize(G, P.B_plain_length, Diag, binary);
+          s[i].resize(3, P.phim);
+          s[i].generateUniform(G, P.B_rand_length);
+        }
+      threads.run(n, [&](int j, int thread)
+        { int i=i0+j;
+          rc[thread].assign(s[i][0], s[i][1], s[i][2]);
+          pk.encrypt(ciphertext[j],y[i],rc[thread]);
+        });
+      for (int j=0; j<n; j++)
+        { ciphertext[j].pack(ciphertexts); }
     }
 }
 
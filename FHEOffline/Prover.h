@@ -2,6 +2,7 @@
 #define _Prover
 
 #include "Proof.h"
+#include "ProofThreads.h"
 #include "Tools/MemoryUsage.h"
 
 /* Class for the prover */
@@ -18,6 +19,8 @@ class Prover
   AddableMatrix<bigint> t;
 #endif
 
+  ProofThreads threads;
+
 public:
   size_t volatile_memory;
 
@@ -6,6 +6,7 @@
 #include <FHEOffline/SimpleEncCommit.h>
 #include <FHEOffline/SimpleMachine.h>
 #include "FHEOffline/Producer.h"
+#include "FHEOffline/ProofThreads.h"
 #include "FHEOffline/Sacrificing.h"
 #include "FHE/FHE_Keys.h"
 #include "Tools/time-func.h"
@@ -81,6 +82,15 @@ void MachineBase::parse_options(int argc, const char** argv)
           "-2", // Flag token.
           "--gf2n" // Flag token.
     );
+    opt.add(
+          "1", // Default.
+          0, // Required?
+          1, // Number of args expected.
+          0, // Delimiter if expecting multiple args.
+          "Number of threads per zero-knowledge proof (default: 1)", // Help description.
+          "-pt", // Flag token.
+          "--proof-threads" // Flag token.
+    );
 
     OfflineMachineBase::parse_options(argc, argv);
     opt.get("-h")->getString(hostname);
@@ -88,6 +98,7 @@ void MachineBase::parse_options(int argc, const char** argv)
     opt.get("-s")->getInt(sec);
     drown_sec = max(40, sec);
     opt.get("-f")->getInt(field_size);
+    opt.get("-pt")->getInt(ProofThreads::n_threads);
     use_gf2n = opt.isSet("-2");
     if (use_gf2n)
     {
@@ -3,11 +3,15 @@
 template <class FD, class S>
 Verifier<FD,S>::Verifier(const Proof& proof) : P(proof)
 {
+  z.resize(threads.size());
+  t.resize(threads.size());
 #ifdef LESS_ALLOC_MORE_MEM
-  z.resize(proof.phim);
-  z.allocate_slots(bigint(1) << proof.B_plain_length);
-  t.resize(3, proof.phim);
-  t.allocate_slots(bigint(1) << proof.B_rand_length);
+  for (int i=0; i<threads.size(); i++)
+    { z[i].resize(proof.phim);
+      z[i].allocate_slots(bigint(1) << proof.B_plain_length);
+      t[i].resize(3, proof.phim);
+      t[i].allocate_slots(bigint(1) << proof.B_rand_length);
+    }
 #endif
 }
 
@@ -44,56 +48,58 @@ void Verifier<FD,S>::Stage_2(const vector<int>& e,
                           octetStream& cleartexts,
                           const FHE_PK& pk,bool Diag,bool binary)
 {
-  unsigned int i,k,V=P.V;
+  unsigned int i,V=P.V;
 
   c.unpack(ciphertexts, pk);
   if (c.size() != P.sec)
     throw length_error("number of received ciphertexts incorrect");
 
   // Now check the encryptions are correct
-  int ee;
-  Ciphertext d1(pk.get_params()), d2(pk.get_params());
-  Random_Coins rc(pk.get_params());
   ciphertexts.get(V);
   if (V != P.V)
     throw length_error("number of received commitments incorrect");
   cleartexts.get(V);
   if (V != P.V)
     throw length_error("number of received cleartexts incorrect");
-  for (i=0; i<V; i++)
-    {
-      z.unpack(cleartexts);
-      t.unpack(cleartexts);
-      if (!P.check_bounds(z, t, i))
-        throw runtime_error("preimage out of bounds");
-      d1.unpack(ciphertexts);
-      for (k=0; k<P.sec; k++)
-        { int jj=(i+1)-(k+1);
-          if (jj<0 || jj>= (int) P.sec) { ee=0; }
-          else                          { ee=e[jj]; }
-          if (ee!=0)
-            { add(d1,d1,c.at(jj)); }
-        }
-      rc.assign(t[0], t[1], t[2]);
-      pk.encrypt(d2,z,rc);
-      if (!(d1 == d2))
-        { cout << "Fail Check 6 " << i << endl; 
-          throw runtime_error("ciphertexts don't match");
-        }
-    }
 
-  // Now check decoding z[i]
-  for (i=0; i<V; i++)
-    {
-      if (!Check_Decoding(z,Diag))
-         { cout << "\tCheck : " << i << endl; 
-           throw runtime_error("cleartext isn't diagonal");
-         }
-      if (binary && !z.is_binary())
-        {
-          cout << "Not binary " << i << endl;
-          throw runtime_error("cleartext isn't binary");
+  // Check in chunks of one ciphertext per thread
+  int n_threads=threads.size();
+  vector<Ciphertext> d1(n_threads, pk.get_params()), d2(n_threads, pk.get_params());
+  vector<Random_Coins> rc(n_threads, pk.get_params());
+  for (i=0; i<V; i+=n_threads)
+    { int n=min(n_threads,int(V-i));
+      for (int j=0; j<n; j++)
+        { z[j].unpack(cleartexts);
+          t[j].unpack(cleartexts);
+          d1[j].unpack(ciphertexts);
         }
+      threads.run(n, [&](int j, int thread)
+        { unsigned int ii=i+j;
+          if (!P.check_bounds(z[j], t[j], ii))
+            throw runtime_error("preimage out of bounds");
+          for (unsigned int k=0; k<P.sec; k++)
+            { int jj=(ii+1)-(k+1);
+              if (jj>=0 && jj<(int) P.sec && e[jj]!=0)
+                { add(d1[j],d1[j],c.at(jj)); }
+            }
+          rc[thread].assign(t[j][0], t[j][1], t[j][2]);
+          pk.encrypt(d2[thread],z[j],rc[thread]);
+          if (!(d1[j] == d2[thread]))
+            { cout << "Fail Check 6 " << ii << endl;
+              throw runtime_error("ciphertexts don't match");
+            }
+
+          // Now check decoding z[i]
+          if (!Check_Decoding(z[j],Diag))
+            { cout << "\tCheck : " << ii << endl;
+              throw runtime_error("cleartext isn't diagonal");
+            }
+          if (binary && !z[j].is_binary())
+            {
+              cout << "Not binary " << ii << endl;
+              throw runtime_error("cleartext isn't binary");
+            }
+        });
     }
 }
 
@@ -115,5 +121,15 @@ void Verifier<FD,S>::NIZKPoK(AddableVector<Ciphertext>& c,
 }
 
 
+template <class FD, class S>
+size_t Verifier<FD,S>::report_size(ReportType type)
+{
+  size_t res=0;
+  for (size_t i=0; i<z.size(); i++)
+    { res+=z[i].report_size(type)+t[i].report_size(type); }
+  return res;
+}
+
+
 template class Verifier<FFT_Data, bigint>;
 template class Verifier<P2Data, bigint>;
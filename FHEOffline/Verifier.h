@@ -2,16 +2,20 @@
 #define _Verifier
 
 #include "Proof.h"
+#include "ProofThreads.h"
 
 /* Defines the Verifier */
 template <class FD, class S>
 class Verifier
 {
-  AddableVector<S> z;
-  AddableMatrix<S> t;
+  // One preimage per thread
+  vector< AddableVector<S> > z;
+  vector< AddableMatrix<S> > t;
 
   const Proof& P;
 
+  ProofThreads threads;
+
 public:
   Verifier(const Proof& proof);
 
@@ -26,7 +30,7 @@ public:
   void NIZKPoK(AddableVector<Ciphertext>& c,octetStream& ciphertexts,octetStream& cleartexts,
                const FHE_PK& pk,bool Diag,bool binary=false);
 
-  size_t report_size(ReportType type) { return z.report_size(type) + t.report_size(type); }
+  size_t report_size(ReportType type);
 };
 
 #endif
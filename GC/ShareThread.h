@@ -42,6 +42,10 @@ public:
     void pre_run(Player& P, typename T::mac_key_type mac_key);
     void post_run();
 
+    // for several instances taking turns on one OS thread
+    void activate() { singleton = this; }
+    static void deactivate() { singleton = 0; }
+
     void and_(Processor<T>& processor, const vector<int>& args, bool repeat);
 };
 
@@ -76,6 +76,7 @@
     X(CONVCINT, C0 = Proc.read_Ci(REG1)) \
     X(CONVCBIT, Proc.write_Ci(R0, PC1.get())) \
     X(DABIT, Proc.dabit(INST)) \
+    X(EDABIT, Proc.edabit(INST)) \
 
 #define GC_INSTRUCTIONS \
     X(LDMSBI, S0 = MSI) \
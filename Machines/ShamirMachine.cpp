@@ -6,6 +6,7 @@
 #include <Machines/ShamirMachine.h>
 #include "Protocols/ShamirShare.h"
 #include "Protocols/MaliciousShamirShare.h"
+#include "Protocols/KingShamirShare.h"
 #include "Math/gfp.h"
 #include "Math/gf2n.h"
 
@@ -16,6 +17,7 @@
 #include "Processor/Machine.hpp"
 #include "Protocols/ShamirInput.hpp"
 #include "Protocols/Shamir.hpp"
+#include "Protocols/KingShamir.hpp"
 #include "Protocols/MaliciousRepPrep.hpp"
 #include "Protocols/ShamirMC.hpp"
 #include "Protocols/MaliciousShamirMC.hpp"
@@ -85,6 +87,8 @@ ShamirMachineSpec<T>::ShamirMachineSpec(int argc, const char** argv)
 
 template class ShamirMachineSpec<ShamirShare>;
 template class ShamirMachineSpec<MaliciousShamirShare>;
+template class ShamirMachineSpec<KingShamirShare>;
 
 template class Machine<ShamirShare<gfp>, ShamirShare<gf2n>>;
 template class Machine<MaliciousShamirShare<gfp>, MaliciousShamirShare<gf2n>>;
+template class Machine<KingShamirShare<gfp>, KingShamirShare<gf2n>>;
@@ -0,0 +1,12 @@
+/*
+ * king-shamir-party.cpp
+ *
+ */
+
+#include "Machines/ShamirMachine.h"
+#include "Protocols/KingShamirShare.h"
+
+int main(int argc, const char** argv)
+{
+    ShamirMachineSpec<KingShamirShare>(argc, argv);
+}
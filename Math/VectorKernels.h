@@ -0,0 +1,421 @@
+/*
+ * VectorKernels.h
+ *
+ */
+
+#ifndef MATH_VECTORKERNELS_H_
+#define MATH_VECTORKERNELS_H_
+
+#include "Z2k.h"
+#include "gf2nlong.h"
+#include "Tools/cpu_support.h"
+
+#include <immintrin.h>
+
+/*
+ * Number of 64-bit ring elements that make up a value of type T if
+ * all arithmetic is component-wise modulo 2^n_bits, zero otherwise.
+ * Types with value zero use the element-wise fallback.
+ */
+template<class T>
+struct ring_words
+{
+    static const int value = 0;
+    static const int n_bits = 0;
+};
+
+template<int K>
+struct ring_words<Z2<K>>
+{
+    static const int value = K <= 64;
+    static const int n_bits = K;
+};
+
+template<int K>
+struct ring_words<SignedZ2<K>> : ring_words<Z2<K>>
+{
+};
+
+/*
+ * Number of GF(2^128) elements (gf2n_long) that make up a value of
+ * type T if all arithmetic is component-wise, zero otherwise.
+ */
+template<class T>
+struct gf2n_words
+{
+    static const int value = 0;
+};
+
+template<>
+struct gf2n_words<gf2n_long>
+{
+    static const int value = 1;
+};
+
+inline bool ring_kernels_use_avx2()
+{
+#ifdef __AVX2__
+    static bool res = cpu_has_avx2();
+    return res;
+#else
+    return false;
+#endif
+}
+
+#ifdef __AVX2__
+inline __m256i ring_mullo(__m256i a, __m256i b)
+{
+#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+    return _mm256_mullo_epi64(a, b);
+#else
+    // 64x64->64 multiplication from 32x32->64
+    __m256i lo = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(
+            _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+            _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+#endif
+}
+#endif
+
+inline void ring_add(mp_limb_t* res, const mp_limb_t* x, const mp_limb_t* y,
+        size_t n, mp_limb_t mask)
+{
+    size_t i = 0;
+#ifdef __AVX2__
+    if (ring_kernels_use_avx2())
+    {
+        __m256i m = _mm256_set1_epi64x(mask);
+        for (; i + 4 <= n; i += 4)
+            _mm256_storeu_si256((__m256i*) (res + i),
+                    _mm256_and_si256(m,
+                            _mm256_add_epi64(
+                                    _mm256_loadu_si256((__m256i*) (x + i)),
+                                    _mm256_loadu_si256((__m256i*) (y + i)))));
+    }
+#endif
+    for (; i < n; i++)
+        res[i] = (x[i] + y[i]) & mask;
+}
+
+inline void ring_sub(mp_limb_t* res, const mp_limb_t* x, const mp_limb_t* y,
+        size_t n, mp_limb_t mask)
+{
+    size_t i = 0;
+#ifdef __AVX2__
+    if (ring_kernels_use_avx2())
+    {
+        __m256i m = _mm256_set1_epi64x(mask);
+        for (; i + 4 <= n; i += 4)
+            _mm256_storeu_si256((__m256i*) (res + i),
+                    _mm256_and_si256(m,
+                            _mm256_sub_epi64(
+                                    _mm256_loadu_si256((__m256i*) (x + i)),
+                                    _mm256_loadu_si256((__m256i*) (y + i)))));
+    }
+#endif
+    for (; i < n; i++)
+        res[i] = (x[i] - y[i]) & mask;
+}
+
+// res[L * i + j] = x[L * i + j] * y[i]
+template<int L>
+inline void ring_mul(mp_limb_t* res, const mp_limb_t* x, const mp_limb_t* y,
+        size_t n, mp_limb_t mask)
+{
+    size_t i = 0;
+#ifdef __AVX2__
+    if ((L == 1 or L == 2) and ring_kernels_use_avx2())
+    {
+        __m256i m = _mm256_set1_epi64x(mask);
+        for (; i + 4 / L <= n; i += 4 / L)
+        {
+            __m256i b;
+            if (L == 1)
+                b = _mm256_loadu_si256((__m256i*) (y + i));
+            else
+                b = _mm256_permute4x64_epi64(
+                        _mm256_castsi128_si256(
+                                _mm_loadu_si128((__m128i*) (y + i))), 0x50);
+            __m256i a = _mm256_loadu_si256((__m256i*) (x + L * i));
+            _mm256_storeu_si256((__m256i*) (res + L * i),
+                    _mm256_and_si256(m, ring_mullo(a, b)));
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        mp_limb_t b = y[i];
+        for (int j = 0; j < L; j++)
+            res[L * i + j] = (x[L * i + j] * b) & mask;
+    }
+}
+
+inline void ring_mul_scalar(mp_limb_t* res, mp_limb_t c, const mp_limb_t* x,
+        size_t n, mp_limb_t mask)
+{
+    size_t i = 0;
+#ifdef __AVX2__
+    if (ring_kernels_use_avx2())
+    {
+        __m256i m = _mm256_set1_epi64x(mask);
+        __m256i b = _mm256_set1_epi64x(c);
+        for (; i + 4 <= n; i += 4)
+            _mm256_storeu_si256((__m256i*) (res + i),
+                    _mm256_and_si256(m,
+                            ring_mullo(_mm256_loadu_si256((__m256i*) (x + i)),
+                                    b)));
+    }
+#endif
+    for (; i < n; i++)
+        res[i] = (x[i] * c) & mask;
+}
+
+// reduction modulo x^128 + x^7 + x^2 + x + 1 using that x^128 = 0x87,
+// same result as gf2n_long::reduce()
+inline __m128i gf2n_long_reduce(__m128i hi, __m128i lo)
+{
+    __m128i poly = _mm_set_epi64x(0, 0x87);
+    __m128i t = clmul<0x01>(hi, poly);
+    lo ^= _mm_slli_si128(t, 8);
+    hi ^= _mm_srli_si128(t, 8);
+    return lo ^ clmul<0x00>(hi, poly);
+}
+
+inline bool gf2n_kernels_use_vpclmul()
+{
+#if defined(__VPCLMULQDQ__) && defined(__AVX512F__)
+    static bool res = cpu_has_vpclmul();
+    return res;
+#else
+    return false;
+#endif
+}
+
+#if defined(__VPCLMULQDQ__) && defined(__AVX512F__)
+// four independent products in GF(2^128)
+inline __m512i gf2n_long_mul_x4(__m512i a, __m512i b)
+{
+    __m512i lo = _mm512_clmulepi64_epi128(a, b, 0x00);
+    __m512i hi = _mm512_clmulepi64_epi128(a, b, 0x11);
+    __m512i mid = _mm512_clmulepi64_epi128(a, b, 0x01)
+            ^ _mm512_clmulepi64_epi128(a, b, 0x10);
+    lo ^= _mm512_bslli_epi128(mid, 8);
+    hi ^= _mm512_bsrli_epi128(mid, 8);
+    __m512i poly = _mm512_broadcast_i32x4(_mm_set_epi64x(0, 0x87));
+    __m512i t = _mm512_clmulepi64_epi128(hi, poly, 0x01);
+    lo ^= _mm512_bslli_epi128(t, 8);
+    hi ^= _mm512_bsrli_epi128(t, 8);
+    return lo ^ _mm512_clmulepi64_epi128(hi, poly, 0x00);
+}
+#endif
+
+// res[L * i + j] = x[L * i + j] * y[i * y_step] in GF(2^128)
+template<int L>
+inline void gf2n_long_mul(__m128i* res, const __m128i* x, const __m128i* y,
+        size_t n, size_t y_step = 1)
+{
+    size_t i = 0;
+#if defined(__VPCLMULQDQ__) && defined(__AVX512F__)
+    if ((L == 1 or L == 2) and gf2n_kernels_use_vpclmul())
+    {
+        for (; i + 4 / L <= n; i += 4 / L)
+        {
+            __m512i b;
+            if (y_step == 0)
+                b = _mm512_broadcast_i32x4(_mm_loadu_si128(y));
+            else if (L == 1)
+                b = _mm512_loadu_si512(y + i);
+            else
+                b = _mm512_permutexvar_epi64(
+                        _mm512_set_epi64(3, 2, 3, 2, 1, 0, 1, 0),
+                        _mm512_castsi256_si512(
+                                _mm256_loadu_si256((__m256i*) (y + i))));
+            _mm512_storeu_si512(res + L * i,
+                    gf2n_long_mul_x4(_mm512_loadu_si512(x + L * i), b));
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        __m128i b = y[i * y_step];
+        for (int j = 0; j < L; j++)
+        {
+            __m128i lo, hi;
+            mul128(x[L * i + j], b, &lo, &hi);
+            res[L * i + j] = gf2n_long_reduce(hi, lo);
+        }
+    }
+}
+
+// sum of x[i] * y[i] in GF(2^128), reducing only once
+inline __m128i gf2n_long_inner_product(const __m128i* x, const __m128i* y,
+        size_t n)
+{
+    __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+    size_t i = 0;
+#if defined(__VPCLMULQDQ__) && defined(__AVX512F__)
+    if (gf2n_kernels_use_vpclmul() and n >= 4)
+    {
+        __m512i lo4 = _mm512_setzero_si512(), mid4 = lo4, hi4 = lo4;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m512i a = _mm512_loadu_si512(x + i);
+            __m512i b = _mm512_loadu_si512(y + i);
+            lo4 ^= _mm512_clmulepi64_epi128(a, b, 0x00);
+            hi4 ^= _mm512_clmulepi64_epi128(a, b, 0x11);
+            mid4 ^= _mm512_clmulepi64_epi128(a, b, 0x01)
+                    ^ _mm512_clmulepi64_epi128(a, b, 0x10);
+        }
+        lo4 ^= _mm512_bslli_epi128(mid4, 8);
+        hi4 ^= _mm512_bsrli_epi128(mid4, 8);
+        __m128i tmp[2][4];
+        _mm512_storeu_si512(tmp[0], lo4);
+        _mm512_storeu_si512(tmp[1], hi4);
+        for (int j = 0; j < 4; j++)
+        {
+            lo ^= tmp[0][j];
+            hi ^= tmp[1][j];
+        }
+    }
+#endif
+    for (; i < n; i++)
+    {
+        __m128i l, h;
+        mul128(x[i], y[i], &l, &h);
+        lo ^= l;
+        hi ^= h;
+    }
+    return gf2n_long_reduce(hi, lo);
+}
+
+/*
+ * Arithmetic on contiguous register ranges for vectorized instructions.
+ * Types consisting of 64-bit ring elements (see ring_words) use AVX2
+ * if available, types consisting of GF(2^128) elements (see gf2n_words)
+ * use batched PCLMUL or VPCLMULQDQ, and everything else (e.g., gfp) is
+ * processed element by element.
+ */
+template<class T>
+class VectorKernels
+{
+    static const int N = ring_words<T>::value;
+    static const int N_BITS = ring_words<T>::n_bits;
+    static const int G = gf2n_words<T>::value;
+
+    static_assert(N == 0 or sizeof(T) == N * sizeof(mp_limb_t),
+            "ring elements must be contiguous");
+    static_assert(G == 0 or sizeof(T) == G * sizeof(__m128i),
+            "field elements must be contiguous");
+
+    static mp_limb_t mask()
+    {
+        return N_BITS % 64 ? mp_limb_t(-1) >> (64 - N_BITS % 64) : mp_limb_t(-1);
+    }
+
+    template<class U>
+    static mp_limb_t* limbs(U* x)
+    {
+        return (mp_limb_t*) x;
+    }
+    template<class U>
+    static const mp_limb_t* limbs(const U* x)
+    {
+        return (const mp_limb_t*) x;
+    }
+
+    template<class U>
+    static __m128i* words(U* x)
+    {
+        return (__m128i*) x;
+    }
+    template<class U>
+    static const __m128i* words(const U* x)
+    {
+        return (const __m128i*) x;
+    }
+
+    static void gf2n_add(T* res, const T* x, const T* y, int size)
+    {
+        for (int i = 0; i < size * G; i++)
+            words(res)[i] = words(x)[i] ^ words(y)[i];
+    }
+
+    template<class U, class V>
+    static T inner_product(const U* x, const V* y, int size, true_type)
+    {
+        return T(int128(gf2n_long_inner_product(words(x), words(y), size)));
+    }
+    template<class U, class V>
+    static T inner_product(const U* x, const V* y, int size, false_type)
+    {
+        T res, tmp;
+        res.assign_zero();
+        for (int i = 0; i < size; i++)
+        {
+            tmp = x[i] * y[i];
+            res.add(res, tmp);
+        }
+        return res;
+    }
+
+public:
+    static void add(T* res, const T* x, const T* y, int size)
+    {
+        if (N > 0)
+            ring_add(limbs(res), limbs(x), limbs(y), size * N, mask());
+        else if (G > 0)
+            gf2n_add(res, x, y, size);
+        else
+            for (int i = 0; i < size; i++)
+                res[i].add(x[i], y[i]);
+    }
+
+    static void sub(T* res, const T* x, const T* y, int size)
+    {
+        if (N > 0)
+            ring_sub(limbs(res), limbs(x), limbs(y), size * N, mask());
+        else if (G > 0)
+            gf2n_add(res, x, y, size);
+        else
+            for (int i = 0; i < size; i++)
+                res[i].sub(x[i], y[i]);
+    }
+
+    // multiplication by one clear value per element
+    template<class U>
+    static void mul(T* res, const T* x, const U* y, int size)
+    {
+        if (N > 0 and ring_words<U>::value == 1
+                and ring_words<U>::n_bits == N_BITS)
+            ring_mul<N ? N : 1>(limbs(res), limbs(x), limbs(y), size, mask());
+        else if (G > 0 and gf2n_words<U>::value == 1)
+            gf2n_long_mul<G ? G : 1>(words(res), words(x), words(y), size);
+        else
+            for (int i = 0; i < size; i++)
+                res[i].mul(x[i], y[i]);
+    }
+
+    static void mul_scalar(T* res, const T& c, const T* x, int size)
+    {
+        if (N == 1)
+            ring_mul_scalar(limbs(res), *limbs(&c), limbs(x), size, mask());
+        else if (G == 1)
+            gf2n_long_mul<1>(words(res), words(x), words(&c), size, 0);
+        else
+            for (int i = 0; i < size; i++)
+                res[i].mul(c, x[i]);
+    }
+
+    // sum of x[i] * y[i]
+    template<class U, class V>
+    static T inner_product(const U* x, const V* y, int size)
+    {
+        return inner_product(x, y, size,
+                integral_constant<bool,
+                        G == 1 and gf2n_words<U>::value == 1
+                                and gf2n_words<V>::value == 1>());
+    }
+};
+
+#endif /* MATH_VECTORKERNELS_H_ */
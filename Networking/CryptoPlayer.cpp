@@ -89,7 +89,7 @@ CryptoPlayer::~CryptoPlayer()
     }
 }
 
-void CryptoPlayer::pass_around_no_stats(octetStream& to_send,
+void CryptoPlayer::pass_around_no_stats(const octetStream& to_send,
         octetStream& to_receive, int offset) const
 {
     if (&to_send == &to_receive or (get_player(offset) == get_player(-offset)))
@@ -26,7 +26,7 @@ public:
 
     bool is_encrypted() { return true; }
 
-    void pass_around_no_stats(octetStream& to_send, octetStream& to_receive, int offset) const;
+    void pass_around_no_stats(const octetStream& to_send, octetStream& to_receive, int offset) const;
 };
 
 #endif /* NETWORKING_CRYPTOPLAYER_H_ */
@@ -0,0 +1,308 @@
+/*
+ * EpollPlayer.cpp
+ *
+ */
+
+#include "EpollPlayer.h"
+#include "Exceptions/Exceptions.h"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+EpollPlayer::Transfer::Transfer(int player, const octetStream* to_send,
+    octetStream* to_receive) :
+    player(player), to_send(to_send), to_receive(to_receive), done(0)
+{
+  if (to_send)
+    {
+      encode_length(header, to_send->get_length(), LENGTH_SIZE);
+      total = LENGTH_SIZE + to_send->get_length();
+    }
+  else
+    // to be extended once the length is known
+    total = LENGTH_SIZE;
+}
+
+EpollPlayer::EpollPlayer(const Names& Nms, int id_base) :
+    PlainPlayer(Nms, id_base), epoll_fd(-1)
+{
+#ifdef __linux__
+  epoll_fd = epoll_create1(0);
+  if (epoll_fd < 0)
+    error("epoll_create1");
+  for (int i = 0; i < nplayers; i++)
+    if (i != player_no)
+      {
+        // edge-triggered, so the sockets can stay registered
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+        event.data.u32 = i;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sockets[i], &event) < 0)
+          error("epoll_ctl");
+      }
+#endif
+}
+
+EpollPlayer::~EpollPlayer()
+{
+  if (epoll_fd >= 0)
+    close(epoll_fd);
+}
+
+void EpollPlayer::progress_send(Transfer& transfer) const
+{
+  iovec iov[2];
+  int n_iov = 0;
+  size_t data_done = 0;
+  if (transfer.done < LENGTH_SIZE)
+    {
+      iov[n_iov].iov_base = transfer.header + transfer.done;
+      iov[n_iov].iov_len = LENGTH_SIZE - transfer.done;
+      n_iov++;
+    }
+  else
+    data_done = transfer.done - LENGTH_SIZE;
+  iov[n_iov].iov_base = transfer.to_send->get_data() + data_done;
+  iov[n_iov].iov_len = transfer.to_send->get_length() - data_done;
+  n_iov++;
+
+  msghdr msg = {};
+  msg.msg_iov = iov;
+  msg.msg_iovlen = n_iov;
+  ssize_t res = sendmsg(sockets[transfer.player], &msg, MSG_DONTWAIT);
+  if (res < 0)
+    {
+      if (errno != EINTR and errno != EAGAIN and errno != EWOULDBLOCK)
+        error("Send error in event loop");
+    }
+  else
+    transfer.done += res;
+}
+
+void EpollPlayer::progress_receive(Transfer& transfer) const
+{
+  auto& os = *transfer.to_receive;
+  octet* buffer;
+  size_t to_receive;
+  if (transfer.done < LENGTH_SIZE)
+    {
+      buffer = transfer.header + transfer.done;
+      to_receive = LENGTH_SIZE - transfer.done;
+    }
+  else
+    {
+      size_t data_done = transfer.done - LENGTH_SIZE;
+      buffer = os.get_data() + data_done;
+      to_receive = transfer.total - transfer.done;
+    }
+
+  ssize_t res = recv(sockets[transfer.player], buffer, to_receive,
+      MSG_DONTWAIT);
+  if (res == 0)
+    throw runtime_error("connection closed while receiving");
+  else if (res < 0)
+    {
+      if (errno != EINTR and errno != EAGAIN and errno != EWOULDBLOCK)
+        error("Receiving error in event loop");
+      return;
+    }
+
+  transfer.done += res;
+  if (transfer.done == LENGTH_SIZE and transfer.total == LENGTH_SIZE)
+    {
+      size_t len = decode_length(transfer.header, LENGTH_SIZE);
+      os.reset_write_head();
+      os.append(len);
+      transfer.total += len;
+    }
+}
+
+void EpollPlayer::progress(Transfer& transfer) const
+{
+  // keep going until the socket would block
+  size_t before;
+  do
+    {
+      before = transfer.done;
+      if (transfer.to_send)
+        progress_send(transfer);
+      else
+        progress_receive(transfer);
+    }
+  while (not transfer.finished() and transfer.done > before);
+}
+
+void EpollPlayer::run(vector<Transfer>& transfers) const
+{
+  size_t n_finished = 0;
+  vector<vector<Transfer*>> by_player(nplayers);
+  for (auto& transfer : transfers)
+    {
+      progress(transfer);
+      if (transfer.finished())
+        n_finished++;
+      else
+        by_player[transfer.player].push_back(&transfer);
+    }
+
+#ifdef __linux__
+  vector<epoll_event> events(nplayers);
+  while (n_finished < transfers.size())
+    {
+      // same timeout as for blocking sockets
+      int n_events = epoll_wait(epoll_fd, events.data(), events.size(),
+          300000);
+      if (n_events < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          error("epoll_wait");
+        }
+      if (n_events == 0)
+        throw runtime_error("timeout in event loop");
+
+      for (int i = 0; i < n_events; i++)
+        for (auto& transfer : by_player[events[i].data.u32])
+          if (not transfer->finished())
+            {
+              progress(*transfer);
+              if (transfer->finished())
+                n_finished++;
+            }
+    }
+#else
+  vector<pollfd> fds;
+  while (n_finished < transfers.size())
+    {
+      fds.clear();
+      for (auto& transfer : transfers)
+        if (not transfer.finished())
+          {
+            pollfd fd = {sockets[transfer.player],
+                short(transfer.to_send ? POLLOUT : POLLIN), 0};
+            fds.push_back(fd);
+          }
+
+      int n_events = poll(fds.data(), fds.size(), 300000);
+      if (n_events < 0)
+        {
+          if (errno == EINTR)
+            continue;
+          error("poll");
+        }
+      if (n_events == 0)
+        throw runtime_error("timeout in event loop");
+
+      for (auto& transfer : transfers)
+        if (not transfer.finished())
+          {
+            progress(transfer);
+            if (transfer.finished())
+              n_finished++;
+          }
+    }
+#endif
+}
+
+void EpollPlayer::send_all(const octetStream& o, bool donthash) const
+{
+  TimeScope ts(comm_stats["Sending to all"].add(o));
+  vector<Transfer> transfers;
+  for (int i = 0; i < nplayers; i++)
+    if (i != player_no)
+      transfers.push_back({i, &o, 0});
+  run(transfers);
+  if (!donthash)
+    { ctx.update(o); }
+  sent += o.get_length() * (num_players() - 1);
+}
+
+void EpollPlayer::receive_all(vector<octetStream>& os) const
+{
+  TimeScope ts(timer);
+  vector<Transfer> transfers;
+  for (int i = 0; i < nplayers; i++)
+    if (i != player_no)
+      transfers.push_back({i, 0, &os[i]});
+  run(transfers);
+  for (int i = 0; i < nplayers; i++)
+    if (i != player_no)
+      comm_stats["Receiving directly"].add(os[i]);
+}
+
+void EpollPlayer::Broadcast_Receive(vector<octetStream>& o, bool donthash) const
+{
+  if (o.size() != sockets.size())
+    throw runtime_error("player numbers don't match");
+  TimeScope ts(comm_stats["Broadcasting"].add(o[player_no]));
+  vector<Transfer> transfers;
+  for (int i = 0; i < nplayers; i++)
+    if (i != player_no)
+      {
+        transfers.push_back({i, &o[player_no], 0});
+        transfers.push_back({i, 0, &o[i]});
+      }
+  run(transfers);
+  if (!donthash)
+    { for (int i=0; i<nplayers; i++)
+        { ctx.update(o[i]); }
+    }
+  sent += o[player_no].get_length() * (num_players() - 1);
+}
+
+void EpollPlayer::pass_around_no_stats(const octetStream& to_send,
+    octetStream& to_receive, int offset) const
+{
+  // receiving overwrites the stream
+  if (&to_send == &to_receive)
+    {
+      PlainPlayer::pass_around_no_stats(to_send, to_receive, offset);
+      return;
+    }
+
+  vector<Transfer> transfers;
+  transfers.push_back({get_player(offset), &to_send, 0});
+  transfers.push_back({get_player(-offset), 0, &to_receive});
+  run(transfers);
+}
+
+void EpollPlayer::send_receive_all_no_stats(
+    const vector<vector<bool>>& channels, const vector<octetStream>& to_send,
+    vector<octetStream>& to_receive) const
+{
+  to_receive.resize(nplayers);
+  vector<Transfer> transfers;
+  for (int i = 0; i < nplayers; i++)
+    if (i != player_no)
+      {
+        if (channels[player_no][i])
+          transfers.push_back({i, &to_send[i], 0});
+        if (channels[i][player_no])
+          transfers.push_back({i, 0, &to_receive[i]});
+      }
+  run(transfers);
+}
+
+void EpollPlayer::partial_broadcast_no_stats(const vector<bool>& senders,
+    vector<octetStream>& os) const
+{
+  os.resize(nplayers);
+  vector<Transfer> transfers;
+  for (int i = 0; i < nplayers; i++)
+    if (i != player_no)
+      {
+        if (senders[player_no])
+          transfers.push_back({i, &os[player_no], 0});
+        if (senders[i])
+          transfers.push_back({i, 0, &os[i]});
+      }
+  run(transfers);
+}
@@ -0,0 +1,54 @@
+/*
+ * EpollPlayer.h
+ *
+ */
+
+#ifndef NETWORKING_EPOLLPLAYER_H_
+#define NETWORKING_EPOLLPLAYER_H_
+
+#include "Player.h"
+
+/*
+ * Player that drives all peer sockets from one event loop.
+ * Sending to and receiving from all other parties happens concurrently
+ * using non-blocking, vectored I/O instead of one peer at a time.
+ * Uses poll() instead where epoll is not available.
+ */
+class EpollPlayer : public PlainPlayer
+{
+  struct Transfer
+  {
+    int player;
+    const octetStream* to_send;
+    octetStream* to_receive;
+    octet header[LENGTH_SIZE];
+    size_t done, total;
+
+    Transfer(int player, const octetStream* to_send, octetStream* to_receive);
+    bool finished() const { return done == total; }
+  };
+
+  int epoll_fd;
+
+  void run(vector<Transfer>& transfers) const;
+  void progress(Transfer& transfer) const;
+  void progress_send(Transfer& transfer) const;
+  void progress_receive(Transfer& transfer) const;
+
+public:
+  EpollPlayer(const Names& Nms, int id_base = 0);
+  ~EpollPlayer();
+
+  void send_all(const octetStream& o, bool donthash = false) const;
+  void receive_all(vector<octetStream>& os) const;
+  void Broadcast_Receive(vector<octetStream>& o, bool donthash = false) const;
+
+  void pass_around_no_stats(const octetStream& to_send,
+      octetStream& to_receive, int offset) const;
+  void send_receive_all_no_stats(const vector<vector<bool>>& channels,
+      const vector<octetStream>& to_send, vector<octetStream>& to_receive) const;
+  void partial_broadcast_no_stats(const vector<bool>& senders,
+      vector<octetStream>& os) const;
+};
+
+#endif /* NETWORKING_EPOLLPLAYER_H_ */
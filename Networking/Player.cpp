@@ -210,7 +210,6 @@ Player::Player(const Names& Nms) :
 {
   nplayers=Nms.nplayers;
   player_no=Nms.player_no;
-  blk_SHA1_Init(&ctx);
 }
 
 
@@ -321,7 +320,7 @@ void Player::send_to(int player,const octetStream& o,bool donthash) const
   TimeScope ts(comm_stats["Sending directly"].add(o));
   send_to_no_stats(player, o);
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
   sent += o.get_length();
 }
 
@@ -342,7 +341,7 @@ void MultiPlayer<T>::send_all(const octetStream& o,bool donthash) const
          { o.Send(sockets[i]); }
      }
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
   sent += o.get_length() * (num_players() - 1);
 }
 
@@ -364,7 +363,7 @@ void Player::receive_player(int i,octetStream& o,bool donthash) const
   receive_player_no_stats(i, o);
   comm_stats["Receiving directly"].add(o, ts);
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
 }
 
 template<class T>
@@ -435,18 +434,84 @@ void Player::exchange_relative(int offset, octetStream& o) const
 
 
 template<class T>
-void MultiPlayer<T>::pass_around_no_stats(octetStream& o, octetStream& to_receive, int offset) const
+void MultiPlayer<T>::pass_around_no_stats(const octetStream& o, octetStream& to_receive, int offset) const
 {
   o.exchange(sockets.at(get_player(offset)), sockets.at(get_player(-offset)), to_receive);
 }
 
-void Player::pass_around(octetStream& o, octetStream& to_receive, int offset) const
+void Player::pass_around(const octetStream& o, octetStream& to_receive, int offset) const
 {
   TimeScope ts(comm_stats["Passing around"].add(o));
   pass_around_no_stats(o, to_receive, offset);
   sent += o.get_length();
 }
 
+void Player::send_receive_all(const vector<vector<bool>>& channels,
+    const vector<octetStream>& to_send, vector<octetStream>& to_receive) const
+{
+  size_t n_sent = 0;
+  for (int i = 0; i < num_players(); i++)
+    if (i != my_num() and channels[my_num()][i])
+      n_sent += to_send[i].get_length();
+  TimeScope ts(comm_stats["Sending/receiving"].add(n_sent));
+  send_receive_all_no_stats(channels, to_send, to_receive);
+  sent += n_sent;
+}
+
+void Player::send_receive_all_no_stats(const vector<vector<bool>>& channels,
+    const vector<octetStream>& to_send, vector<octetStream>& to_receive) const
+{
+  to_receive.resize(num_players());
+  for (int offset = 1; offset < num_players(); offset++)
+    {
+      int receive_from = get_player(-offset);
+      int send_to = get_player(offset);
+      bool receive = channels[receive_from][my_num()];
+      if (channels[my_num()][send_to])
+        {
+          if (receive)
+            pass_around_no_stats(to_send[send_to], to_receive[receive_from],
+                offset);
+          else
+            send_to_no_stats(send_to, to_send[send_to]);
+        }
+      else if (receive)
+        receive_player_no_stats(receive_from, to_receive[receive_from]);
+    }
+}
+
+void Player::partial_broadcast(const vector<bool>& senders,
+    vector<octetStream>& os) const
+{
+  size_t n_sent = 0;
+  if (senders[my_num()])
+    n_sent = os[my_num()].get_length() * (num_players() - 1);
+  TimeScope ts(comm_stats["Partial broadcasting"].add(n_sent));
+  partial_broadcast_no_stats(senders, os);
+  sent += n_sent;
+}
+
+void Player::partial_broadcast_no_stats(const vector<bool>& senders,
+    vector<octetStream>& os) const
+{
+  os.resize(num_players());
+  for (int offset = 1; offset < num_players(); offset++)
+    {
+      int send_to = get_player(offset);
+      int receive_from = get_player(-offset);
+      bool receive = senders[receive_from];
+      if (senders[my_num()])
+        {
+          if (receive)
+            pass_around_no_stats(os[my_num()], os[receive_from], offset);
+          else
+            send_to_no_stats(send_to, os[my_num()]);
+        }
+      else if (receive)
+        receive_player_no_stats(receive_from, os[receive_from]);
+    }
+}
+
 
 /* This is deliberately weird to avoid problems with OS max buffer
  * size getting in the way
@@ -465,7 +530,7 @@ void MultiPlayer<T>::Broadcast_Receive(vector<octetStream>& o,bool donthash) con
     }
   if (!donthash)
     { for (int i=0; i<nplayers; i++)
-        { blk_SHA1_Update(&ctx,o[i].get_data(),o[i].get_length()); }
+        { ctx.update(o[i]); }
     }
   sent += o[player_no].get_length() * (num_players() - 1);
 }
@@ -473,12 +538,10 @@ void MultiPlayer<T>::Broadcast_Receive(vector<octetStream>& o,bool donthash) con
 
 void Player::Check_Broadcast() const
 {
-  if (ctx.size == 0)
+  if (ctx.empty())
     return;
-  octet hashVal[HASH_SIZE];
   vector<octetStream> h(nplayers);
-  blk_SHA1_Final(hashVal,&ctx);
-  h[player_no].append(hashVal,HASH_SIZE);
+  ctx.final(h[player_no]);
 
   Broadcast_Receive(h,true);
   for (int i=0; i<nplayers; i++)
@@ -487,7 +550,7 @@ void Player::Check_Broadcast() const
 	    { throw broadcast_invalid(); }
         }
     }
-  blk_SHA1_Init(&ctx);
+  ctx.reset();
 }
 
 template<>
@@ -581,7 +644,7 @@ void ThreadPlayer::send_all(const octetStream& o,bool donthash) const
      }
 
   if (!donthash)
-    { blk_SHA1_Update(&ctx,o.get_data(),o.get_length()); }
+    { ctx.update(o); }
 
   for (int i = 0; i < nplayers; i++)
     if (i != player_no)
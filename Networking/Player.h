@@ -90,7 +90,8 @@ struct CommStats
   size_t data, rounds;
   Timer timer;
   CommStats() : data(0), rounds(0) {}
-  Timer& add(const octetStream& os) { data += os.get_length(); rounds++; return timer; }
+  Timer& add(size_t length) { data += length; rounds++; return timer; }
+  Timer& add(const octetStream& os) { return add(os.get_length()); }
   void add(const octetStream& os, const TimeScope& scope) { add(os) += scope; }
   CommStats& operator+=(const CommStats& other);
   CommStats& operator-=(const CommStats& other);
@@ -140,7 +141,7 @@ class Player : public PlayerBase
 protected:
   int nplayers;
 
-  mutable blk_SHA_CTX ctx;
+  mutable BroadcastHash ctx;
 
 public:
   const Names& N;
@@ -162,7 +163,7 @@ public:
   virtual void send_all(const octetStream& o,bool donthash=false) const = 0;
   void send_to(int player,const octetStream& o,bool donthash=false) const;
   virtual void send_to_no_stats(int player,const octetStream& o) const = 0;
-  void receive_all(vector<octetStream>& os) const;
+  virtual void receive_all(vector<octetStream>& os) const;
   void receive_player(int i,octetStream& o,bool donthash=false) const;
   virtual void receive_player_no_stats(int i,octetStream& o) const = 0;
   virtual void receive_player(int i,FlexBuffer& buffer) const;
@@ -179,8 +180,24 @@ public:
   void exchange(int other, octetStream& o) const;
   void exchange_relative(int offset, octetStream& o) const;
   void pass_around(octetStream& o, int offset = 1) const { pass_around(o, o, offset); }
-  void pass_around(octetStream& to_send, octetStream& to_receive, int offset) const;
-  virtual void pass_around_no_stats(octetStream& to_send, octetStream& to_receive, int offset) const = 0;
+  void pass_around(const octetStream& to_send, octetStream& to_receive, int offset) const;
+  virtual void pass_around_no_stats(const octetStream& to_send, octetStream& to_receive, int offset) const = 0;
+
+  /* Send to_send[j] to every player j with channels[my_num()][j]
+   * and receive to_receive[i] from every player i with channels[i][my_num()]
+   */
+  void send_receive_all(const vector<vector<bool>>& channels,
+      const vector<octetStream>& to_send, vector<octetStream>& to_receive) const;
+  virtual void send_receive_all_no_stats(const vector<vector<bool>>& channels,
+      const vector<octetStream>& to_send, vector<octetStream>& to_receive) const;
+
+  /* Send os[my_num()] to all if senders[my_num()]
+   * and receive os[i] from every player i with senders[i]
+   */
+  void partial_broadcast(const vector<bool>& senders,
+      vector<octetStream>& os) const;
+  virtual void partial_broadcast_no_stats(const vector<bool>& senders,
+      vector<octetStream>& os) const;
 
   /* Broadcast and Receive data to/from all players
    *  - Assumes o[player_no] contains the thing broadcast by me
@@ -188,7 +205,7 @@ public:
   virtual void Broadcast_Receive(vector<octetStream>& o,bool donthash=false) const = 0;
 
   /* Run Protocol To Verify Broadcast Is Correct
-   *     - Resets the blk_SHA_CTX at the same time
+   *     - Resets the broadcast hash at the same time
    */
   virtual void Check_Broadcast() const;
 
@@ -239,7 +256,7 @@ public:
   void exchange_no_stats(int other, const octetStream& to_send, octetStream& ot_receive) const;
 
   // send to next and receive from previous player
-  virtual void pass_around_no_stats(octetStream& to_send, octetStream& to_receive, int offset) const;
+  virtual void pass_around_no_stats(const octetStream& to_send, octetStream& to_receive, int offset) const;
 
   // Receive one from player i
 
@@ -32,6 +32,12 @@ void DataPositions::increase(const DataPositions& delta)
       const map<DataTag, long long>& delta_ext = delta.extended[field_type];
       for (it = delta_ext.begin(); it != delta_ext.end(); it++)
           extended[field_type][it->first] += it->second;
+
+      for (auto& x : delta.matrices[field_type])
+        matrices[field_type][x.first] += x.second;
+
+      for (auto& x : delta.edabits[field_type])
+        edabits[field_type][x.first] += x.second;
     }
 }
 
@@ -67,6 +73,19 @@ void DataPositions::print_cost() const
           cerr.fill(' ');
           cerr << setw(27) << it->second << " " << setw(14) << it->first.get_string() << endl;
         }
+
+      for (auto& x : matrices[i])
+        {
+          cerr.fill(' ');
+          cerr << setw(27) << x.second << " " << setw(14) << matrix_name(x.first) << endl;
+        }
+
+      for (auto& x : edabits[i])
+        {
+          cerr.fill(' ');
+          cerr << setw(27) << x.second << " " << setw(14)
+              << (to_string(x.first) + "-bit edaBits") << endl;
+        }
     }
 
   if (total_cost > 0)
@@ -8,11 +8,13 @@
 #include "Math/field_types.h"
 #include "Tools/Buffer.h"
 #include "Processor/InputTuple.h"
+#include "Processor/OnlineOptions.h"
 #include "Tools/Lock.h"
 #include "Networking/Player.h"
 
 #include <fstream>
 #include <map>
+#include <array>
 using namespace std;
 
 class DataTag
@@ -53,6 +55,16 @@ public:
   vector< vector<long long> > files;
   vector< vector<long long> > inputs;
   map<DataTag, long long> extended[N_DATA_FIELD_TYPE];
+  // matrix triples by dimensions (rows, inner, columns)
+  map<array<int, 3>, long long> matrices[N_DATA_FIELD_TYPE];
+  // edaBits by bit length
+  map<int, long long> edabits[N_DATA_FIELD_TYPE];
+
+  static string matrix_name(const array<int, 3>& dims)
+  {
+    return "Matrices-" + to_string(dims[0]) + "x" + to_string(dims[1]) + "x"
+        + to_string(dims[2]);
+  }
 
   DataPositions(int num_players = 0) { set_num_players(num_players); }
   void reset() { *this = DataPositions(inputs.size()); }
@@ -76,6 +88,8 @@ protected:
   void count(Dtype dtype) { usage.files[T::field_type()][dtype]++; }
   void count(DataTag tag, int n = 1) { usage.extended[T::field_type()][tag] += n; }
   void count_input(int player) { usage.inputs[player][T::field_type()]++; }
+  void count(const array<int, 3>& dims) { usage.matrices[T::field_type()][dims]++; }
+  void count_edabit(int n_bits) { usage.edabits[T::field_type()][n_bits]++; }
 
 public:
   template<class U, class V>
@@ -104,18 +118,43 @@ public:
   virtual void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs,
       int vector_size) = 0;
 
+  virtual bool has_matrix_triples(const array<int, 3>& dims)
+  {
+    (void) dims;
+    if (OnlineOptions::singleton.matrix_triples)
+      throw runtime_error("matrix triples are only available from files");
+    return false;
+  }
+  virtual void get_matrix_triple_no_count(const array<int, 3>& dims,
+      array<vector<T>, 3>& triple)
+  {
+    (void) dims, (void) triple;
+    throw not_implemented();
+  }
+
   void get(Dtype dtype, T* a);
   void get_three(Dtype dtype, T& a, T& b, T& c);
   void get_two(Dtype dtype, T& a, T& b);
   void get_one(Dtype dtype, T& a);
   void get_input(T& a, typename T::open_type& x, int i);
   void get(vector<T>& S, DataTag tag, const vector<int>& regs, int vector_size);
+  array<vector<T>, 3> get_matrix_triple(const array<int, 3>& dims);
 
   virtual array<T, 3> get_triple(int n_bits);
   virtual void get_dabit(T&, typename T::bit_type&) { throw runtime_error("no daBit"); }
+  virtual bool get_edabit_no_count(T& a, vector<typename T::bit_type>& bits,
+      int n_bits)
+  {
+    (void) a, (void) bits, (void) n_bits;
+    return false;
+  }
+  void get_edabit(T& a, vector<typename T::bit_type>& bits, int n_bits);
 
   virtual void buffer_triples() {}
   virtual void buffer_inverses() {}
+
+  // prepare for the given usage in advance if possible
+  virtual void forecast(const DataPositions& usage) { (void) usage; }
 };
 
 template<class T>
@@ -132,6 +171,7 @@ class Sub_Data_Files : public Preprocessing<T>
   vector<BufferOwner<T, T>> input_buffers;
   BufferOwner<InputTuple<T>, RefInputTuple<T>> my_input_buffers;
   map<DataTag, BufferOwner<T, T> > extended;
+  map<array<int, 3>, BufferOwner<T, T> > matrix_buffers;
 
   int my_num,num_players;
 
@@ -189,6 +229,10 @@ public:
 
   void setup_extended(const DataTag& tag, int tuple_size = 0);
   void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs, int vector_size);
+
+  bool has_matrix_triples(const array<int, 3>& dims);
+  void get_matrix_triple_no_count(const array<int, 3>& dims,
+      array<vector<T>, 3>& triple);
 };
 
 template<class sint, class sgf2n>
@@ -211,6 +255,12 @@ class Data_Files
   void prune();
   void purge();
 
+  void forecast(const DataPositions& usage)
+  {
+    DataFp.forecast(usage);
+    DataF2.forecast(usage);
+  }
+
   DataPositions get_usage()
   {
     return usage;
@@ -297,6 +347,39 @@ inline void Preprocessing<T>::get(vector<T>& S, DataTag tag,
   get_no_count(S, tag, regs, vector_size);
 }
 
+template<class T>
+inline array<vector<T>, 3> Preprocessing<T>::get_matrix_triple(
+    const array<int, 3>& dims)
+{
+  count(dims);
+  array<vector<T>, 3> res;
+  get_matrix_triple_no_count(dims, res);
+  return res;
+}
+
+template<class T>
+void Preprocessing<T>::get_edabit(T& a, vector<typename T::bit_type>& bits,
+    int n_bits)
+{
+  if (get_edabit_no_count(a, bits, n_bits))
+    {
+      count_edabit(n_bits);
+      return;
+    }
+
+  // fall back to composing daBits
+  bits.resize(n_bits);
+  vector<T> as(n_bits);
+  for (int i = 0; i < n_bits; i++)
+    get_dabit(as[i], bits[i]);
+  a = {};
+  for (int i = n_bits - 1; i >= 0; i--)
+    {
+      a += a;
+      a += as[i];
+    }
+}
+
 template<class T>
 array<T, 3> Preprocessing<T>::get_triple(int n_bits)
 {
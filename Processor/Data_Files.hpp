@@ -5,6 +5,9 @@
 #include "Processor/Processor.h"
 
 #include "Protocols/ReplicatedPrep.hpp"
+#include "Protocols/BackgroundPrep.hpp"
+
+#include <sys/stat.h>
 
 template<class T>
 Lock Sub_Data_Files<T>::tuple_lengths_lock;
@@ -24,7 +27,9 @@ Preprocessing<T>* Preprocessing<T>::get_new(
     Machine<U, V>& machine,
     DataPositions& usage, SubProcessor<T>* proc)
 {
-  if (machine.live_prep)
+  if (machine.live_prep and OnlineOptions::singleton.background_batches > 0)
+    return new BackgroundPrep<T>(proc, usage);
+  else if (machine.live_prep)
     return get_live_prep(proc, usage);
   else
     return new Sub_Data_Files<T>(machine.get_N(), machine.prep_dir_prefix, usage);
@@ -62,6 +67,7 @@ Sub_Data_Files<T>::Sub_Data_Files(int my_num, int num_players,
 #endif
   char filename[1024];
   string suffix = get_suffix(thread_num);
+  bool mapped = OnlineOptions::singleton.mapped_files;
   for (int dtype = 0; dtype < N_DTYPE; dtype++)
     {
       if (T::clear::allows(Dtype(dtype)))
@@ -69,7 +75,7 @@ Sub_Data_Files<T>::Sub_Data_Files(int my_num, int num_players,
           sprintf(filename,(prep_data_dir + "%s-%s-P%d%s").c_str(),DataPositions::dtype_names[dtype],
               (T::type_short()).c_str(),my_num,suffix.c_str());
           buffers[dtype].setup(filename,
-              tuple_length(dtype), DataPositions::dtype_names[dtype]);
+              tuple_length(dtype), DataPositions::dtype_names[dtype], mapped);
         }
     }
 
@@ -80,10 +86,10 @@ Sub_Data_Files<T>::Sub_Data_Files(int my_num, int num_players,
           (T::type_short()).c_str(),my_num,i,suffix.c_str());
       if (i == my_num)
         my_input_buffers.setup(filename,
-            T::size() * 3 / 2);
+            InputTuple<T>::size(), "", mapped);
       else
         input_buffers[i].setup(filename,
-            T::size());
+            T::size(), "", mapped);
     }
 
 #ifdef DEBUG_FILES
@@ -118,6 +124,8 @@ Sub_Data_Files<T>::~Sub_Data_Files()
   for (auto it =
       extended.begin(); it != extended.end(); it++)
     it->second.close();
+  for (auto& x : matrix_buffers)
+    x.second.close();
 }
 
 template<class T>
@@ -138,6 +146,9 @@ void Sub_Data_Files<T>::seekg(DataPositions& pos)
       setup_extended(it->first);
       extended[it->first].seekg(it->second);
     }
+  for (auto& x : pos.matrices[field_type])
+    if (has_matrix_triples(x.first))
+      matrix_buffers[x.first].seekg(x.second);
 }
 
 template<class sint, class sgf2n>
@@ -166,6 +177,8 @@ void Sub_Data_Files<T>::prune()
     input_buffers[j].prune();
   for (auto it : extended)
     it.second.prune();
+  for (auto& x : matrix_buffers)
+    x.second.prune();
 }
 
 template<class sint, class sgf2n>
@@ -185,6 +198,8 @@ void Sub_Data_Files<T>::purge()
     input_buffers[j].purge();
   for (auto it : extended)
     it.second.purge();
+  for (auto& x : matrix_buffers)
+    x.second.purge();
 }
 
 template<class T>
@@ -206,14 +221,15 @@ void Sub_Data_Files<T>::setup_extended(const DataTag& tag, int tuple_size)
         }
     }
   else
-    tuple_lengths[tag] = my_tuple_length;
+    tuple_length = tuple_lengths[tag] = my_tuple_length;
   tuple_lengths_lock.unlock();
 
   if (!buffer.is_up())
     {
       stringstream ss;
       ss << prep_data_dir << tag.get_string() << "-" << T::type_short() << "-P" << my_num;
-      extended[tag].setup(ss.str(), tuple_length);
+      extended[tag].setup(ss.str(), tuple_length, "",
+          OnlineOptions::singleton.mapped_files);
     }
 }
 
@@ -226,4 +242,43 @@ void Sub_Data_Files<T>::get_no_count(vector<T>& S, DataTag tag, const vector<int
       extended[tag].input(S[regs[i] + j]);
 }
 
+template<class T>
+bool Sub_Data_Files<T>::has_matrix_triples(const array<int, 3>& dims)
+{
+  // all parties have to take the same path, so this is not decided
+  // by the presence of the file
+  if (not OnlineOptions::singleton.matrix_triples)
+    return false;
+
+  auto& buffer = matrix_buffers[dims];
+  if (buffer.is_up())
+    return true;
+
+  stringstream ss;
+  ss << prep_data_dir << DataPositions::matrix_name(dims) << "-"
+      << T::type_short() << "-P" << my_num;
+  struct stat st;
+  if (stat(ss.str().c_str(), &st) != 0)
+    throw file_error("matrix triples in " + ss.str());
+
+  int tuple_size = dims[0] * dims[1] + dims[1] * dims[2] + dims[0] * dims[2];
+  buffer.setup(ss.str(), tuple_size * T::size(), "Matrices",
+      OnlineOptions::singleton.mapped_files);
+  return true;
+}
+
+template<class T>
+void Sub_Data_Files<T>::get_matrix_triple_no_count(const array<int, 3>& dims,
+    array<vector<T>, 3>& triple)
+{
+  // row-major (rows x inner), (inner x columns), and (rows x columns)
+  triple[0].resize(dims[0] * dims[1]);
+  triple[1].resize(dims[1] * dims[2]);
+  triple[2].resize(dims[0] * dims[2]);
+  auto& buffer = matrix_buffers.at(dims);
+  for (auto& matrix : triple)
+    for (auto& x : matrix)
+      buffer.input(x);
+}
+
 #endif
@@ -13,6 +13,8 @@ struct InputTuple
   T share;
   typename T::open_type value;
 
+  typedef typename T::clear clear;
+
   static int size()
     { return T::open_type::size() + T::size(); }
 
@@ -41,6 +43,11 @@ struct RefInputTuple
   typename T::open_type& value;
   RefInputTuple(T& share, typename T::open_type& value) : share(share), value(value) {}
   void operator=(InputTuple<T>& other) { share = other.share; value = other.value; }
+  void assign(const char* buffer)
+    {
+      share.assign(buffer);
+      value.assign(buffer + T::size());
+    }
 };
 
 
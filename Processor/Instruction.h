@@ -61,6 +61,7 @@ enum
     USE_PREP = 0x1C,
     STARTGRIND = 0x1D,
     STOPGRIND = 0x1E,
+    USE_MATMUL = 0x1F,
     NPLAYERS = 0xE2,
     THRESHOLD = 0xE3,
     PLAYERID = 0xE4,
@@ -96,6 +97,7 @@ enum
     MULRS = 0xA7,
     DOTPRODS = 0xA8,
     TRUNC_PR = 0xA9,
+    MATMULS = 0xAA,
     // Data access
     TRIPLE = 0x50,
     BIT = 0x51,
@@ -104,6 +106,7 @@ enum
     INPUTMASK = 0x56,
     PREP = 0x57,
     DABIT = 0x58,
+    EDABIT = 0x59,
     // Input
     INPUT = 0x60,
     INPUTFIX = 0xF0,
@@ -226,6 +229,7 @@ enum
     GMULS = 0x1A6,
     GMULRS = 0x1A7,
     GDOTPRODS = 0x1A8,
+    GMATMULS = 0x1AA,
     // Data access
     GTRIPLE = 0x150,
     GBIT = 0x151,
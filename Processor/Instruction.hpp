@@ -5,6 +5,7 @@
 #include "Processor/IntInput.h"
 #include "Processor/FixInput.h"
 #include "Processor/FloatInput.h"
+#include "Math/VectorKernels.h"
 #include "Exceptions/Exceptions.h"
 #include "Tools/time-func.h"
 #include "Tools/parse.h"
@@ -283,6 +284,12 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       case PRINTFLOATPLAINB:
         get_vector(4, start, s);
         break;
+      // result, two addresses, and three dimensions
+      case MATMULS:
+      case GMATMULS:
+        get_ints(r, s, 3);
+        get_vector(3, start, s);
+        break;
       // open instructions + read/write instructions with variable length args
       case WRITEFILESHARE:
       case OPEN:
@@ -318,6 +325,7 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       case READSOCKETS:
       case READSOCKETINT:
       case READCLIENTPUBLICKEY:   
+      case EDABIT:
         num_var_args = get_int(s) - 1;
         r[0] = get_int(s);
         get_vector(num_var_args, start, s);
@@ -373,6 +381,11 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
         s.read((char*)r, sizeof(r));
         n = get_int(s);
         break;
+      case USE_MATMUL:
+        get_ints(r, s, 1);
+        get_vector(3, start, s);
+        n = get_int(s);
+        break;
       case REQBL:
         n = get_int(s);
         BaseMachine::s().reqbl(n);
@@ -464,6 +477,11 @@ bool Instruction::get_offline_data_usage(DataPositions& usage)
     case GUSE_PREP:
       usage.extended[gf2n::field_type()][r] = n;
       return int(n) >= 0;
+    case USE_MATMUL:
+      if (r[0] >= N_DATA_FIELD_TYPE)
+        throw invalid_program();
+      usage.matrices[r[0]][{{start[0], start[1], start[2]}}] = n;
+      return int(n) >= 0;
     default:
       return true;
   }
@@ -507,6 +525,9 @@ int BaseInstruction::get_reg_type() const
     case GUSE_PREP:
       // those use r[] for a string
       return NONE;
+    case USE_MATMUL:
+      // dimensions are not registers
+      return NONE;
     default:
       if (is_gf2n_instruction())
         return GF2N;
@@ -528,6 +549,14 @@ unsigned BaseInstruction::get_max_reg(int reg_type) const
           return r[0] + size;
   }
 
+  if (opcode == EDABIT)
+  {
+      if (reg_type == SBIT)
+          return *max_element(start.begin(), start.end()) + 1;
+      else if (reg_type == MODP)
+          return r[0] + size;
+  }
+
   if (get_reg_type() != reg_type) { return 0; }
 
   int skip = 0;
@@ -535,6 +564,9 @@ unsigned BaseInstruction::get_max_reg(int reg_type) const
 
   switch (opcode)
   {
+  case MATMULS:
+  case GMATMULS:
+      return r[0] + start[0] * start[2];
   case DOTPRODS:
   {
       int res = 0;
@@ -655,12 +687,20 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
   switch (opcode)
   {
     case GADDC:
-      for (int i = 0; i < size; i++)
-        Proc.get_C2_ref(r[0] + i).add(Proc.read_C2(r[1] + i),Proc.read_C2(r[2] + i));
+      VectorKernels<typename sgf2n::clear>::add(&Proc.get_C2_ref(r[0]),
+          &Proc.read_C2(r[1]), &Proc.read_C2(r[2]), size);
       return;
     case GADDS:
-      for (int i = 0; i < size; i++)
-        Proc.get_S2_ref(r[0] + i).add(Proc.read_S2(r[1] + i),Proc.read_S2(r[2] + i));
+      VectorKernels<sgf2n>::add(&Proc.get_S2_ref(r[0]), &Proc.read_S2(r[1]),
+          &Proc.read_S2(r[2]), size);
+      return;
+    case GSUBC:
+      VectorKernels<typename sgf2n::clear>::sub(&Proc.get_C2_ref(r[0]),
+          &Proc.read_C2(r[1]), &Proc.read_C2(r[2]), size);
+      return;
+    case GSUBS:
+      VectorKernels<sgf2n>::sub(&Proc.get_S2_ref(r[0]), &Proc.read_S2(r[1]),
+          &Proc.read_S2(r[2]), size);
       return;
     case GMOVC:
       for (int i = 0; i < size; i++)
@@ -679,8 +719,17 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         Proc.get_C2_ref(r[0] + i).SHR(Proc.read_C2(r[1] + i),n);
       return;
     case GMULM:
-      for (int i = 0; i < size; i++)
-         Proc.get_S2_ref(r[0] + i).mul(Proc.read_S2(r[1] + i),Proc.read_C2(r[2] + i));
+      VectorKernels<sgf2n>::mul(&Proc.get_S2_ref(r[0]), &Proc.read_S2(r[1]),
+          &Proc.read_C2(r[2]), size);
+      return;
+    case GMULC:
+      VectorKernels<typename sgf2n::clear>::mul(&Proc.get_C2_ref(r[0]),
+          &Proc.read_C2(r[1]), &Proc.read_C2(r[2]), size);
+      return;
+    case GMULCI:
+      Proc.temp.ans2.assign(int(n));
+      VectorKernels<typename sgf2n::clear>::mul_scalar(&Proc.get_C2_ref(r[0]),
+          Proc.temp.ans2, &Proc.read_C2(r[1]), size);
       return;
     case LDI:
       Proc.temp.assign_ansp(n);
@@ -688,12 +737,12 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         Proc.write_Cp(r[0] + i,Proc.temp.ansp);
       return;
     case ADDC:
-      for (int i = 0; i < size; i++)
-        Proc.get_Cp_ref(r[0] + i).add(Proc.read_Cp(r[1] + i),Proc.read_Cp(r[2] + i));
+      VectorKernels<typename sint::clear>::add(&Proc.get_Cp_ref(r[0]),
+          &Proc.read_Cp(r[1]), &Proc.read_Cp(r[2]), size);
       return;
     case ADDS:
-      for (int i = 0; i < size; i++)
-        Proc.get_Sp_ref(r[0] + i).add(Proc.read_Sp(r[1] + i),Proc.read_Sp(r[2] + i));
+      VectorKernels<sint>::add(&Proc.get_Sp_ref(r[0]), &Proc.read_Sp(r[1]),
+          &Proc.read_Sp(r[2]), size);
       return;
     case ADDM:
       for (int i = 0; i < size; i++)
@@ -704,9 +753,13 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       for (int i = 0; i < size; i++)
          Proc.get_Cp_ref(r[0] + i).add(Proc.temp.ansp,Proc.read_Cp(r[1] + i));
       return;
+    case SUBC:
+      VectorKernels<typename sint::clear>::sub(&Proc.get_Cp_ref(r[0]),
+          &Proc.read_Cp(r[1]), &Proc.read_Cp(r[2]), size);
+      return;
     case SUBS:
-      for (int i = 0; i < size; i++)
-        Proc.get_Sp_ref(r[0] + i).sub(Proc.read_Sp(r[1] + i),Proc.read_Sp(r[2] + i));
+      VectorKernels<sint>::sub(&Proc.get_Sp_ref(r[0]), &Proc.read_Sp(r[1]),
+          &Proc.read_Sp(r[2]), size);
       return;
     case SUBSFI:
       Proc.temp.assign_ansp(n);
@@ -714,17 +767,17 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         Proc.get_Sp_ref(r[0] + i).sub(Proc.temp.ansp,Proc.read_Sp(r[1] + i),Proc.P.my_num(),Proc.MCp.get_alphai());
       return;
     case MULM:
-      for (int i = 0; i < size; i++)
-        Proc.get_Sp_ref(r[0] + i).mul(Proc.read_Sp(r[1] + i),Proc.read_Cp(r[2] + i));
+      VectorKernels<sint>::mul(&Proc.get_Sp_ref(r[0]), &Proc.read_Sp(r[1]),
+          &Proc.read_Cp(r[2]), size);
       return;
     case MULC:
-      for (int i = 0; i < size; i++)
-        Proc.get_Cp_ref(r[0] + i).mul(Proc.read_Cp(r[1] + i),Proc.read_Cp(r[2] + i));
+      VectorKernels<typename sint::clear>::mul(&Proc.get_Cp_ref(r[0]),
+          &Proc.read_Cp(r[1]), &Proc.read_Cp(r[2]), size);
       return;
     case MULCI:
       Proc.temp.assign_ansp(n);
-      for (int i = 0; i < size; i++)
-        Proc.get_Cp_ref(r[0] + i).mul(Proc.temp.ansp,Proc.read_Cp(r[1] + i));
+      VectorKernels<typename sint::clear>::mul_scalar(&Proc.get_Cp_ref(r[0]),
+          Proc.temp.ansp, &Proc.read_Cp(r[1]), size);
       return;
     case TRIPLE:
       for (int i = 0; i < size; i++)
@@ -1281,7 +1334,7 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         Proc.Proc2.POpen(start, Proc.P, size);
         return;
       case MULS:
-        Proc.Procp.muls(start, size);
+        Proc.Procp.protocol.muls(start, Proc.Procp, Proc.MCp, size);
         return;
       case GMULS:
         Proc.Proc2.protocol.muls(start, Proc.Proc2, Proc.MC2, size);
@@ -1298,6 +1351,14 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       case GDOTPRODS:
         Proc.Proc2.dotprods(start, size);
         return;
+      case MATMULS:
+        Proc.Procp.protocol.matmuls(Proc.machine.Mp, *this,
+            Proc.read_Ci(r[1]), Proc.read_Ci(r[2]), Proc.Procp);
+        return;
+      case GMATMULS:
+        Proc.Proc2.protocol.matmuls(Proc.machine.M2, *this,
+            Proc.read_Ci(r[1]), Proc.read_Ci(r[2]), Proc.Proc2);
+        return;
       case TRUNC_PR:
         Proc.Procp.protocol.trunc_pr(start, size, Proc.Procp);
         return;
@@ -1385,43 +1446,52 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         Proc.write_Ci(r[0], Proc.read_C2(r[1]).get_word());
         break;
       case PRINTMEM:
+        Proc.check();
 	  { Proc.out << "Mem[" <<  r[0] << "] = " << Proc.machine.Mp.read_C(r[0]) << endl; }
         break;
       case GPRINTMEM:
+        Proc.check();
 	  { Proc.out << "Mem[" <<  r[0] << "] = " << Proc.machine.M2.read_C(r[0]) << endl; }
         break;
       case PRINTREG:
+        Proc.check();
            {
              Proc.out << "Reg[" << r[0] << "] = " << Proc.read_Cp(r[0])
               << " # " << string((char*)&n,sizeof(n)) << endl;
            }
         break;
       case GPRINTREG:
+        Proc.check();
            {
              Proc.out << "Reg[" << r[0] << "] = " << Proc.read_C2(r[0])
               << " # " << string((char*)&n,sizeof(n)) << endl;
            }
         break;
       case PRINTREGPLAIN:
+        Proc.check();
            {
              Proc.out << Proc.read_Cp(r[0]) << flush;
            }
         break;
       case CONDPRINTPLAIN:
+        Proc.check();
         if (not Proc.read_Cp(r[0]).is_zero())
           Proc.out << Proc.read_Cp(r[1]) << flush;
         break;
       case GPRINTREGPLAIN:
+        Proc.check();
            {
              Proc.out << Proc.read_C2(r[0]) << flush;
            }
         break;
       case PRINTINT:
+        Proc.check();
            {
              Proc.out << Proc.read_Ci(r[0]) << flush;
            }
         break;
       case PRINTFLOATPLAIN:
+        Proc.check();
           {
             typename sint::clear v = Proc.read_Cp(start[0]);
             typename sint::clear p = Proc.read_Cp(start[1]);
@@ -1441,6 +1511,7 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
            }
         break;
       case CONDPRINTSTR:
+        Proc.check();
           if (not Proc.read_Cp(r[0]).is_zero())
             Proc.out << string((char*)&n,sizeof(n)) << flush;
         break;
@@ -1450,11 +1521,13 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
            }
         break;
       case PRINTCHRINT:
+        Proc.check();
            {
              Proc.out << string((char*)&(Proc.read_Ci(r[0])),1) << flush;
            }
         break;
       case PRINTSTRINT:
+        Proc.check();
            {
              Proc.out << string((char*)&(Proc.read_Ci(r[0])),sizeof(int)) << flush;
            }
@@ -1468,6 +1541,7 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       case USE_INP:
       case USE_PREP:
       case GUSE_PREP:
+      case USE_MATMUL:
         break;
       case TIME:
         Proc.machine.time();
@@ -1554,9 +1628,11 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         //Proc.get_S2_ref(r[0]).get_mac().pack(socket_octetstream);
         break;
       case WRITESOCKETINT:
+        Proc.check();
         Proc.write_socket(INT, CLEAR, false, Proc.read_Ci(r[0]), r[1], start);
         break;
       case WRITESOCKETC:
+        Proc.check();
         Proc.write_socket(MODP, CLEAR, false, Proc.read_Ci(r[0]), r[1], start);
         break;
       case WRITESOCKETS:
@@ -1584,9 +1660,11 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
         Proc.public_input >> Proc.get_Ci_ref(r[0]);
         break;
       case RAWOUTPUT:
+        Proc.check();
         Proc.read_Cp(r[0]).output(Proc.public_output, false);
         break;
       case GRAWOUTPUT:
+        Proc.check();
         Proc.read_C2(r[0]).output(Proc.public_output, false);
         break;
       case STARTPRIVATEOUTPUT:
@@ -1627,6 +1705,112 @@ void Program::execute(Processor<sint, sgf2n>& Proc) const
 {
   unsigned int size = p.size();
   Proc.PC=0;
+#ifdef __GNUC__
+  // threaded dispatch using computed goto, one indirect jump per handler
+  static const void* const handlers[] = {
+#define X(NAME) &&handle_##NAME,
+    DECODED_HANDLERS
+#undef X
+  };
+
+  auto code = decoded.data();
+  const DecodedInstruction* d;
+
+#define DISPATCH \
+  if (Proc.PC >= size) \
+    return; \
+  d = &code[Proc.PC]; \
+  goto *handlers[d->handler]
+
+  DISPATCH;
+
+handle_FALLBACK:
+  p[Proc.PC].execute(Proc);
+  DISPATCH;
+handle_LDINT:
+  Proc.write_Ci(d->r[0], d->n);
+  Proc.PC++;
+  DISPATCH;
+handle_ADDINT:
+  Proc.get_Ci_ref(d->r[0]) = Proc.read_Ci(d->r[1]) + Proc.read_Ci(d->r[2]);
+  Proc.PC++;
+  DISPATCH;
+handle_SUBINT:
+  Proc.get_Ci_ref(d->r[0]) = Proc.read_Ci(d->r[1]) - Proc.read_Ci(d->r[2]);
+  Proc.PC++;
+  DISPATCH;
+handle_MULINT:
+  Proc.get_Ci_ref(d->r[0]) = Proc.read_Ci(d->r[1]) * Proc.read_Ci(d->r[2]);
+  Proc.PC++;
+  DISPATCH;
+handle_MOVINT:
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]));
+  Proc.PC++;
+  DISPATCH;
+handle_EQZC:
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]) == 0);
+  Proc.PC++;
+  DISPATCH;
+handle_LTZC:
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]) < 0);
+  Proc.PC++;
+  DISPATCH;
+handle_LTC:
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]) < Proc.read_Ci(d->r[2]));
+  Proc.PC++;
+  DISPATCH;
+handle_GTC:
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]) > Proc.read_Ci(d->r[2]));
+  Proc.PC++;
+  DISPATCH;
+handle_EQC:
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]) == Proc.read_Ci(d->r[2]));
+  Proc.PC++;
+  DISPATCH;
+handle_JMP:
+  Proc.PC += 1 + d->n;
+  DISPATCH;
+handle_JMPNZ:
+  Proc.PC++;
+  if (Proc.read_Ci(d->r[0]) != 0)
+    Proc.PC += d->n;
+  DISPATCH;
+handle_JMPEQZ:
+  Proc.PC++;
+  if (Proc.read_Ci(d->r[0]) == 0)
+    Proc.PC += d->n;
+  DISPATCH;
+handle_PUSHINT:
+  Proc.pushi(Proc.read_Ci(d->r[0]));
+  Proc.PC++;
+  DISPATCH;
+handle_POPINT:
+  Proc.popi(Proc.get_Ci_ref(d->r[0]));
+  Proc.PC++;
+  DISPATCH;
+handle_LDINT_ADDINT:
+  Proc.write_Ci(d->r[0], d->n);
+  d++;
+  Proc.get_Ci_ref(d->r[0]) = Proc.read_Ci(d->r[1]) + Proc.read_Ci(d->r[2]);
+  Proc.PC += 2;
+  DISPATCH;
+handle_LDINT_LTC:
+  Proc.write_Ci(d->r[0], d->n);
+  d++;
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]) < Proc.read_Ci(d->r[2]));
+  Proc.PC += 2;
+  DISPATCH;
+handle_LTC_JMPNZ:
+  Proc.write_Ci(d->r[0], Proc.read_Ci(d->r[1]) < Proc.read_Ci(d->r[2]));
+  d++;
+  Proc.PC += 2;
+  if (Proc.read_Ci(d->r[0]) != 0)
+    Proc.PC += d->n;
+  DISPATCH;
+
+#undef DISPATCH
+#else
   while (Proc.PC<size)
     { p[Proc.PC].execute(Proc); }
+#endif
 }
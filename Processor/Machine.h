@@ -16,6 +16,7 @@
 #include "GC/Machine.h"
 
 #include "Tools/time-func.h"
+#include "Tools/WaitQueue.h"
 
 #include <vector>
 #include <map>
@@ -34,6 +35,9 @@ class Machine : public BaseMachine
   vector<thread_info<sint, sgf2n>> tinfo;
   vector<pthread_t> threads;
 
+  // alternatively, a pool of workers runs the tapes of all threads
+  vector<pthread_t> workers;
+
   int my_number;
   Names& N;
   typename sint::mac_key_type alphapi;
@@ -48,6 +52,9 @@ class Machine : public BaseMachine
 
   void load_program(string threadname, string filename);
 
+  void finish_threads();
+  void finish_workers();
+
   public:
 
   vector<pthread_mutex_t> t_mutex;
@@ -55,6 +62,8 @@ class Machine : public BaseMachine
   vector<pthread_cond_t>  server_ready;
   vector<Program>  progs;
 
+  WaitQueue<tape_job<sint, sgf2n>> tape_jobs;
+
   Memory<sgf2n> M2;
   Memory<sint> Mp;
   Memory<Integer> Mi;
@@ -15,6 +15,7 @@
 #include <string>
 #include <fstream>
 #include <pthread.h>
+#include <thread>
 using namespace std;
 
 template<class sint, class sgf2n>
@@ -141,7 +142,12 @@ Machine<sint, sgf2n>::Machine(int my_number, Names& playerNames,
 
   /* Set up the threads */
   tinfo.resize(nthreads);
-  threads.resize(nthreads);
+  if (opts.tape_workers < 0)
+    workers.resize(max(1u, thread::hardware_concurrency()));
+  else if (opts.tape_workers > 0)
+    workers.resize(opts.tape_workers);
+  else
+    threads.resize(nthreads);
   t_mutex.resize(nthreads);
   client_ready.resize(nthreads);
   server_ready.resize(nthreads);
@@ -161,9 +167,15 @@ Machine<sint, sgf2n>::Machine(int my_number, Names& playerNames,
       tinfo[i].machine=this;
       // lock for synchronization
       pthread_mutex_lock(&t_mutex[i]);
-      pthread_create(&threads[i],NULL,thread_info<sint, sgf2n>::Main_Func,&tinfo[i]);
+      if (workers.empty())
+        pthread_create(&threads[i],NULL,thread_info<sint, sgf2n>::Main_Func,&tinfo[i]);
+      else
+        tape_jobs.push({&tinfo[i], tape_job<sint, sgf2n>::SETUP, -1});
     }
 
+  for (auto& worker : workers)
+    pthread_create(&worker, NULL, tape_job<sint, sgf2n>::Worker_Func, this);
+
   // synchronize with clients before starting timer
   for (int i=0; i<nthreads; i++)
     {
@@ -205,8 +217,12 @@ DataPositions Machine<sint, sgf2n>::run_tape(int thread_number, int tape_number,
   tinfo[thread_number].pos=pos;
   tinfo[thread_number].finished=false;
   //printf("Send signal to run program %d in thread %d\n",tape_number,thread_number);
-  pthread_cond_signal(&server_ready[thread_number]);
+  if (workers.empty())
+    pthread_cond_signal(&server_ready[thread_number]);
   pthread_mutex_unlock(&t_mutex[thread_number]);
+  if (not workers.empty())
+    tape_jobs.push({&tinfo[thread_number], tape_job<sint, sgf2n>::RUN,
+        tape_number});
   //printf("Running line %d\n",exec);
   if (progs[tape_number].usage_unknown())
     {
@@ -242,12 +258,91 @@ void Machine<sint, sgf2n>::join_tape(int i)
   join_timer[i].start();
   pthread_mutex_lock(&t_mutex[i]);
   //printf("Waiting for client to terminate\n");
-  if ((tinfo[i].finished)==false)
+  if (tape_job<sint, sgf2n>::current)
+    {
+      // tape running on a worker, so work on other tapes in the meantime
+      // instead of possibly blocking the last available worker
+      tape_job<sint, sgf2n> job = {0, tape_job<sint, sgf2n>::RUN, -1};
+      while (not tinfo[i].finished)
+        {
+          pthread_mutex_unlock(&t_mutex[i]);
+          bool found = tape_jobs.try_pop(job);
+          if (found)
+            job.run();
+          pthread_mutex_lock(&t_mutex[i]);
+          if (not found and not tinfo[i].finished)
+            pthread_cond_wait(&client_ready[i],&t_mutex[i]);
+        }
+    }
+  else if ((tinfo[i].finished)==false)
     { pthread_cond_wait(&client_ready[i],&t_mutex[i]); }
   pthread_mutex_unlock(&t_mutex[i]);
   join_timer[i].stop();
 }
 
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::finish_threads()
+{
+  // Tell all C-threads to stop
+  for (int i=0; i<nthreads; i++)
+    { pthread_mutex_lock(&t_mutex[i]);
+	//printf("Send kill signal to client\n");
+        tinfo[i].prognum=-1;
+        tinfo[i].ready = false;
+        pthread_cond_signal(&server_ready[i]);
+      pthread_mutex_unlock(&t_mutex[i]);
+    }
+
+  // reset to sum actual usage
+  pos.reset();
+
+#ifdef DEBUG_THREADS
+  cerr << "Waiting for all clients to finish" << endl;
+#endif
+  // Wait until all clients have signed out
+  for (int i=0; i<nthreads; i++)
+    {
+      pthread_mutex_lock(&t_mutex[i]);
+      tinfo[i].ready = true;
+      pthread_cond_signal(&server_ready[i]);
+      pthread_mutex_unlock(&t_mutex[i]);
+      pthread_join(threads[i],NULL);
+      pthread_mutex_destroy(&t_mutex[i]);
+      pthread_cond_destroy(&client_ready[i]);
+      pthread_cond_destroy(&server_ready[i]);
+      pos.increase(tinfo[i].pos);
+    }
+}
+
+template<class sint, class sgf2n>
+void Machine<sint, sgf2n>::finish_workers()
+{
+  for (int i=0; i<nthreads; i++)
+    {
+      pthread_mutex_lock(&t_mutex[i]);
+      tinfo[i].finished=false;
+      pthread_mutex_unlock(&t_mutex[i]);
+      tape_jobs.push({&tinfo[i], tape_job<sint, sgf2n>::FINISH, -1});
+    }
+
+  // reset to sum actual usage
+  pos.reset();
+
+  for (int i=0; i<nthreads; i++)
+    join_tape(i);
+  tape_jobs.stop();
+  for (auto& worker : workers)
+    pthread_join(worker, NULL);
+
+  for (int i=0; i<nthreads; i++)
+    {
+      pthread_mutex_destroy(&t_mutex[i]);
+      pthread_cond_destroy(&client_ready[i]);
+      pthread_cond_destroy(&server_ready[i]);
+      pos.increase(tinfo[i].pos);
+    }
+}
+
 template<class sint, class sgf2n>
 void Machine<sint, sgf2n>::run()
 {
@@ -295,35 +390,10 @@ void Machine<sint, sgf2n>::run()
   print_compiler();
 
   finish_timer.start();
-  // Tell all C-threads to stop
-  for (int i=0; i<nthreads; i++)
-    { pthread_mutex_lock(&t_mutex[i]);
-	//printf("Send kill signal to client\n");
-        tinfo[i].prognum=-1;
-        tinfo[i].ready = false;
-        pthread_cond_signal(&server_ready[i]);
-      pthread_mutex_unlock(&t_mutex[i]);
-    }
-
-  // reset to sum actual usage
-  pos.reset();
-
-#ifdef DEBUG_THREADS
-  cerr << "Waiting for all clients to finish" << endl;
-#endif
-  // Wait until all clients have signed out
-  for (int i=0; i<nthreads; i++)
-    {
-      pthread_mutex_lock(&t_mutex[i]);
-      tinfo[i].ready = true;
-      pthread_cond_signal(&server_ready[i]);
-      pthread_mutex_unlock(&t_mutex[i]);
-      pthread_join(threads[i],NULL);
-      pthread_mutex_destroy(&t_mutex[i]);
-      pthread_cond_destroy(&client_ready[i]);
-      pthread_cond_destroy(&server_ready[i]);
-      pos.increase(tinfo[i].pos);
-    }
+  if (workers.empty())
+    finish_threads();
+  else
+    finish_workers();
   finish_timer.stop();
   
 #ifdef VERBOSE
@@ -5,15 +5,22 @@
 #include "Math/gf2n.h"
 #include "Math/Integer.h"
 #include "Processor/Data_Files.h"
+#include "Tools/time-func.h"
 
 #include <vector>
 using namespace std;
 
 template<class sint, class sgf2n> class Machine;
+template<class sint, class sgf2n> class Processor;
 
 template<class sint, class sgf2n>
 class thread_info
 {
+  typename sgf2n::MAC_Check* MC2;
+  typename sint::MAC_Check*  MCp;
+  Processor<sint, sgf2n>* processor;
+  DataPositions actual_usage;
+
   public: 
 
   int thread_num;
@@ -32,10 +39,47 @@ class thread_info
 
   Machine<sint, sgf2n>* machine;
 
+  Player* player;
+  Timer thread_timer, wait_timer;
+
+  thread_info();
+
+  // steps of an online thread, callable from any OS thread
+  void setup();
+  void run_tape(int program);
+  void finish();
+  void activate();
+
   static void* Main_Func(void *ptr);
 
   static void purge_preprocessing(Machine<sint, sgf2n>& machine);
 };
 
+/*
+ * Job for the pool of workers that run tapes if the number of
+ * OS threads is decoupled from the number of program threads
+ */
+template<class sint, class sgf2n>
+class tape_job
+{
+  public:
+
+  enum job_type { SETUP, RUN, FINISH };
+
+  // program thread served by this OS thread at the moment
+  static thread_local thread_info<sint, sgf2n>* current;
+
+  thread_info<sint, sgf2n>* tinfo;
+  job_type type;
+  int program;
+
+  void run();
+
+  static void* Worker_Func(void *ptr);
+};
+
+template<class sint, class sgf2n>
+thread_local thread_info<sint, sgf2n>* tape_job<sint, sgf2n>::current = 0;
+
 #endif
 
@@ -6,6 +6,7 @@
 #include "Processor/Machine.h"
 #include "Processor/Processor.h"
 #include "Networking/CryptoPlayer.h"
+#include "Networking/EpollPlayer.h"
 
 #include "Processor/Processor.hpp"
 #include "Processor/Input.hpp"
@@ -17,63 +18,68 @@ using namespace std;
 
 
 template<class sint, class sgf2n>
-void* Sub_Main_Func(void* ptr)
+thread_info<sint, sgf2n>::thread_info() :
+    MC2(0), MCp(0), processor(0), thread_num(0), covert(0), Nms(0),
+    alpha2i(0), alphapi(0), prognum(-2), finished(true), ready(false),
+    arg(0), machine(0), player(0), thread_timer(CLOCK_THREAD_CPUTIME_ID)
 {
-  bigint::init_thread();
+}
 
-  thread_info<sint, sgf2n> *tinfo=(thread_info<sint, sgf2n> *) ptr;
-  Machine<sint, sgf2n>& machine=*(tinfo->machine);
-  vector<pthread_mutex_t>& t_mutex      = machine.t_mutex;
-  vector<pthread_cond_t>& client_ready  = machine.client_ready;
-  vector<pthread_cond_t>& server_ready  = machine.server_ready;
-  vector<Program>& progs                = machine.progs;
+template<class sint, class sgf2n>
+void thread_info<sint, sgf2n>::setup()
+{
+  vector<pthread_mutex_t>& t_mutex      = machine->t_mutex;
+  vector<pthread_cond_t>& client_ready  = machine->client_ready;
 
-  int num=tinfo->thread_num;
+  int num=thread_num;
   BaseMachine::s().thread_num = num;
 
 #ifdef DEBUG_THREADS
   fprintf(stderr, "\tI am in thread %d\n",num);
 #endif
-  Player* player;
-  if (machine.use_encryption)
+  if (machine->use_encryption)
     {
 #ifdef VERBOSE
       cerr << "Using encrypted single-threaded communication" << endl;
 #endif
-      player = new CryptoPlayer(*(tinfo->Nms), num << 16);
+      player = new CryptoPlayer(*Nms, num << 16);
     }
-  else if (!machine.receive_threads or machine.direct or machine.parallel)
+  else if (machine->opts.event_loop)
+    {
+#ifdef VERBOSE
+      cerr << "Using event loop for communication" << endl;
+#endif
+      player = new EpollPlayer(*Nms, num << 16);
+    }
+  else if (!machine->receive_threads or machine->direct or machine->parallel)
     {
 #ifdef VERBOSE
       cerr << "Using single-threaded receiving" << endl;
 #endif
-      player = new PlainPlayer(*(tinfo->Nms), num << 16);
+      player = new PlainPlayer(*Nms, num << 16);
     }
   else
     {
       cerr << "Using player-specific threads for receiving" << endl;
-      player = new ThreadPlayer(*(tinfo->Nms), num << 16);
+      player = new ThreadPlayer(*Nms, num << 16);
     }
   Player& P = *player;
 #ifdef DEBUG_THREADS
   fprintf(stderr, "\tSet up player in thread %d\n",num);
 #endif
 
-  typename sgf2n::MAC_Check* MC2;
-  typename sint::MAC_Check*  MCp;
-
   // Use MAC_Check instead for more than 10000 openings at once
-  if (machine.direct)
+  if (machine->direct)
     {
       cerr << "Using direct communication. If computation stalls, use -m when compiling." << endl;
-      MC2 = new typename sgf2n::Direct_MC(*(tinfo->alpha2i),*(tinfo->Nms), num);
-      MCp = new typename sint::Direct_MC(*(tinfo->alphapi),*(tinfo->Nms), num);
+      MC2 = new typename sgf2n::Direct_MC(*alpha2i,*Nms, num);
+      MCp = new typename sint::Direct_MC(*alphapi,*Nms, num);
     }
-  else if (machine.parallel)
+  else if (machine->parallel)
     {
       cerr << "Using indirect communication with background threads." << endl;
-      //MC2 = new Parallel_MAC_Check<gf2n>(*(tinfo->alpha2i),*(tinfo->Nms), num, machine.opening_sum, machine.max_broadcast);
-      //MCp = new Parallel_MAC_Check<gfp>(*(tinfo->alphapi),*(tinfo->Nms), num, machine.opening_sum, machine.max_broadcast);
+      //MC2 = new Parallel_MAC_Check<gf2n>(*alpha2i,*Nms, num, machine->opening_sum, machine->max_broadcast);
+      //MCp = new Parallel_MAC_Check<gfp>(*alphapi,*Nms, num, machine->opening_sum, machine->max_broadcast);
       throw not_implemented();
     }
   else
@@ -81,30 +87,147 @@ void* Sub_Main_Func(void* ptr)
 #ifdef VERBOSE
       cerr << "Using indirect communication." << endl;
 #endif
-      MC2 = new typename sgf2n::MAC_Check(*(tinfo->alpha2i), machine.opening_sum, machine.max_broadcast);
-      MCp = new typename sint::MAC_Check(*(tinfo->alphapi), machine.opening_sum, machine.max_broadcast);
+      MC2 = new typename sgf2n::MAC_Check(*alpha2i, machine->opening_sum, machine->max_broadcast);
+      MCp = new typename sint::MAC_Check(*alphapi, machine->opening_sum, machine->max_broadcast);
     }
 
-  // Allocate memory for first program before starting the clock
-  auto processor = new Processor<sint, sgf2n>(tinfo->thread_num,P,*MC2,*MCp,machine,progs[0]);
-  auto& Proc = *processor;
+  // the OS thread might have set up another program thread before
+  GC::ShareThread<typename sint::bit_type>::deactivate();
 
-  bool flag=true;
-  int program=-3; 
-  // int exec=0;
+  // Allocate memory for first program before starting the clock
+  processor = new Processor<sint, sgf2n>(thread_num,P,*MC2,*MCp,*machine,machine->progs[0]);
+  actual_usage.set_num_players(P.num_players());
 
   // synchronize
 #ifdef DEBUG_THREADS
   cerr << "Locking for sync of thread " << num << endl;
 #endif
   pthread_mutex_lock(&t_mutex[num]);
-  tinfo->ready=true;
+  ready=true;
   pthread_cond_signal(&client_ready[num]);
   pthread_mutex_unlock(&t_mutex[num]);
+}
+
+template<class sint, class sgf2n>
+void thread_info<sint, sgf2n>::activate()
+{
+  BaseMachine::s().thread_num = thread_num;
+  processor->share_thread.activate();
+}
+
+template<class sint, class sgf2n>
+void thread_info<sint, sgf2n>::run_tape(int program)
+{
+  vector<pthread_mutex_t>& t_mutex      = machine->t_mutex;
+  vector<pthread_cond_t>& client_ready  = machine->client_ready;
+  vector<Program>& progs                = machine->progs;
+  auto& Proc = *processor;
+  Player& P = *player;
+  int num = thread_num;
+
+  //printf("\tClient %d about to run %d in execution %d\n",num,program,exec);
+  Proc.reset(progs[program],arg);
+
+  // Bits, Triples, Squares, and Inverses skipping
+  Proc.DataF.seekg(pos);
+  // reset for actual usage
+  Proc.DataF.reset_usage();
+
+  // generate what the tape is known to need before running it
+  if (OnlineOptions::singleton.forecast_batch_size > 0)
+    Proc.DataF.forecast(progs[program].get_offline_data_used());
+
+  //printf("\tExecuting program");
+  // Execute the program
+  progs[program].execute(Proc);
+
+  actual_usage.increase(Proc.DataF.get_usage());
+
+  if (progs[program].usage_unknown())
+    { // communicate file positions to main thread
+      pos.increase(Proc.DataF.get_usage());
+    }
+
+  //double elapsed = timeval_diff(&startv, &endv);
+  //printf("Thread time = %f seconds\n",elapsed/1000000);
+  //printf("\texec = %d\n",exec); exec++;
+  //printf("\tMC2.number = %d\n",MC2.number());
+  //printf("\tMCp.number = %d\n",MCp.number());
+
+  // MACCheck
+  MC2->Check(P);
+  MCp->Check(P);
+  //printf("\tMAC checked\n");
+  P.Check_Broadcast();
+  //printf("\tBroadcast checked\n");
+
+  // printf("\tSignalling I have finished\n");
+  wait_timer.start();
+  pthread_mutex_lock(&t_mutex[num]);
+  finished=true;
+  pthread_cond_signal(&client_ready[num]);
+  pthread_mutex_unlock(&t_mutex[num]);
+  wait_timer.stop();
+}
+
+template<class sint, class sgf2n>
+void thread_info<sint, sgf2n>::finish()
+{
+  Player& P = *player;
+
+  // destruct protocol before last MAC check and data statistics
+  size_t prep_sent = processor->DataF.data_sent();
+  prep_sent += processor->share_thread.DataF.data_sent();
+  delete processor;
+  processor = 0;
+
+  // MACCheck
+  MC2->Check(P);
+  MCp->Check(P);
+
+  //cout << num << " : Checking broadcast" << endl;
+  P.Check_Broadcast();
+  //cout << num << " : Broadcast checked "<< endl;
+
+#ifdef VERBOSE
+  cerr << thread_num << " : MAC Checking" << endl;
+  cerr << "\tMC2.number=" << MC2->number() << endl;
+  cerr << "\tMCp.number=" << MCp->number() << endl;
+
+  cerr << "Thread " << thread_num << " timer: " << thread_timer.elapsed() << endl;
+  cerr << "Thread " << thread_num << " wait timer: " << wait_timer.elapsed() << endl;
+#endif
+
+  machine->data_sent += P.sent + prep_sent;
+  pos = actual_usage;
 
-  DataPositions actual_usage(P.num_players());
-  Timer thread_timer(CLOCK_THREAD_CPUTIME_ID), wait_timer;
-  thread_timer.start();
+  delete MC2;
+  delete MCp;
+  delete player;
+  MC2 = 0;
+  MCp = 0;
+  player = 0;
+}
+
+template<class sint, class sgf2n>
+void* Sub_Main_Func(void* ptr)
+{
+  bigint::init_thread();
+
+  thread_info<sint, sgf2n> *tinfo=(thread_info<sint, sgf2n> *) ptr;
+  Machine<sint, sgf2n>& machine=*(tinfo->machine);
+  vector<pthread_mutex_t>& t_mutex      = machine.t_mutex;
+  vector<pthread_cond_t>& server_ready  = machine.server_ready;
+
+  int num=tinfo->thread_num;
+  tinfo->setup();
+
+  bool flag=true;
+  int program=-3; 
+  // int exec=0;
+
+  Timer& wait_timer = tinfo->wait_timer;
+  tinfo->thread_timer.start();
 
   while (flag)
     { // Wait until I have a program to run
@@ -126,60 +249,12 @@ void* Sub_Main_Func(void* ptr)
         }
       else
         { // RUN PROGRAM
-          //printf("\tClient %d about to run %d in execution %d\n",num,program,exec);
-          Proc.reset(progs[program],tinfo->arg);
-
-          // Bits, Triples, Squares, and Inverses skipping
-          Proc.DataF.seekg(tinfo->pos);
-          // reset for actual usage
-          Proc.DataF.reset_usage();
-             
-          //printf("\tExecuting program");
-          // Execute the program
-          progs[program].execute(Proc);
-
-          actual_usage.increase(Proc.DataF.get_usage());
-
-         if (progs[program].usage_unknown())
-           { // communicate file positions to main thread
-             tinfo->pos.increase(Proc.DataF.get_usage());
-           }
-
-          //double elapsed = timeval_diff(&startv, &endv);
-          //printf("Thread time = %f seconds\n",elapsed/1000000);
-          //printf("\texec = %d\n",exec); exec++;
-          //printf("\tMC2.number = %d\n",MC2.number());
-          //printf("\tMCp.number = %d\n",MCp.number());
-
-          // MACCheck
-          MC2->Check(P);
-          MCp->Check(P);
-          //printf("\tMAC checked\n");
-          P.Check_Broadcast();
-          //printf("\tBroadcast checked\n");
-
-         // printf("\tSignalling I have finished\n");
-          wait_timer.start();
-         pthread_mutex_lock(&t_mutex[num]);
-            (tinfo->finished)=true;
-            pthread_cond_signal(&client_ready[num]);
-	 pthread_mutex_unlock(&t_mutex[num]);
-	 wait_timer.stop();
+          tinfo->run_tape(program);
        }  
     }
 
-  // destruct protocol before last MAC check and data statistics
-  size_t prep_sent = Proc.DataF.data_sent();
-  prep_sent += Proc.share_thread.DataF.data_sent();
-  delete processor;
-
-  // MACCheck
-  MC2->Check(P);
-  MCp->Check(P);
-  
-  //cout << num << " : Checking broadcast" << endl;
-  P.Check_Broadcast();
-  //cout << num << " : Broadcast checked "<< endl;
+  tinfo->thread_timer.stop();
+  tinfo->finish();
 
   wait_timer.start();
   pthread_mutex_lock(&t_mutex[num]);
@@ -188,22 +263,6 @@ void* Sub_Main_Func(void* ptr)
   pthread_mutex_unlock(&t_mutex[num]);
   wait_timer.stop();
 
-#ifdef VERBOSE
-  cerr << num << " : MAC Checking" << endl;
-  cerr << "\tMC2.number=" << MC2->number() << endl;
-  cerr << "\tMCp.number=" << MCp->number() << endl;
-
-  cerr << "Thread " << num << " timer: " << thread_timer.elapsed() << endl;
-  cerr << "Thread " << num << " wait timer: " << wait_timer.elapsed() << endl;
-#endif
-
-  machine.data_sent += P.sent + prep_sent;
-  tinfo->pos = actual_usage;
-
-  delete MC2;
-  delete MCp;
-  delete player;
-
 #if OPENSSL_VERSION_NUMBER >= 0x10100000L
   OPENSSL_thread_stop();
 #endif
@@ -247,3 +306,73 @@ void thread_info<sint, sgf2n>::purge_preprocessing(Machine<sint, sgf2n>& machine
           << "SECURITY FAILURE; YOU ARE ON YOUR OWN NOW!" << endl;
   }
 }
+
+
+template<class sint, class sgf2n>
+void tape_job<sint, sgf2n>::run()
+{
+  auto& machine = *tinfo->machine;
+  auto previous = current;
+  // the tape waiting for this one is not charged for it
+  if (previous)
+    previous->thread_timer.stop();
+  current = tinfo;
+
+  switch (type)
+  {
+  case SETUP:
+    tinfo->setup();
+    break;
+  case RUN:
+    tinfo->activate();
+    tinfo->thread_timer.start();
+    tinfo->run_tape(program);
+    tinfo->thread_timer.stop();
+    break;
+  case FINISH:
+    tinfo->activate();
+    tinfo->finish();
+    pthread_mutex_lock(&machine.t_mutex[tinfo->thread_num]);
+    tinfo->finished = true;
+    pthread_cond_signal(&machine.client_ready[tinfo->thread_num]);
+    pthread_mutex_unlock(&machine.t_mutex[tinfo->thread_num]);
+    break;
+  }
+
+  // back to the tape that was helping out
+  current = previous;
+  if (current)
+    {
+      current->activate();
+      current->thread_timer.start();
+    }
+}
+
+template<class sint, class sgf2n>
+void* tape_job<sint, sgf2n>::Worker_Func(void* ptr)
+{
+  bigint::init_thread();
+  Machine<sint, sgf2n>& machine = *(Machine<sint, sgf2n>*) ptr;
+  tape_job<sint, sgf2n> job = {0, SETUP, -1};
+
+#ifndef INSECURE
+  try
+#endif
+  {
+      // first come, first served, so all parties start the same jobs
+      while (machine.tape_jobs.pop(job))
+        job.run();
+  }
+#ifndef INSECURE
+  catch (...)
+  {
+      thread_info<sint, sgf2n>::purge_preprocessing(machine);
+      throw;
+  }
+#endif
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+  OPENSSL_thread_stop();
+#endif
+  return 0;
+}
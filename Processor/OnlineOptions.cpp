@@ -5,6 +5,7 @@
 
 #include "OnlineOptions.h"
 #include "Math/gfp.h"
+#include "Tools/sha1.h"
 
 using namespace std;
 
@@ -17,6 +18,15 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     live_prep = true;
     batch_size = 10000;
     memtype = "empty";
+    background_batches = 0;
+    mapped_files = false;
+    event_loop = false;
+    broadcast_hash = "sha1";
+    tape_workers = 0;
+    forecast_batch_size = 0;
+    opening = TREE_OPENING;
+    lazy_mac_check = false;
+    matrix_triples = false;
 }
 
 OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
@@ -98,6 +108,101 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-m", // Flag token.
             "--memory" // Flag token.
     );
+    opt.add(
+            "0", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Generate live preprocessing in background threads, "
+            "keeping up to n batches ahead (default: 0, disabled)", // Help description.
+            "-bg", // Flag token.
+            "--background-prep" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Map preprocessing files into memory instead of reading them", // Help description.
+            "-mm", // Flag token.
+            "--mmap-preprocessing" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Communicate with all parties concurrently in one event loop", // Help description.
+            "-el", // Flag token.
+            "--event-loop" // Flag token.
+    );
+    opt.add(
+            "sha1", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Hash for checking broadcast consistency (sha1, blake2b; "
+            "default: sha1)", // Help description.
+            "-bh", // Flag token.
+            "--broadcast-hash" // Flag token.
+    );
+    opt.add(
+            "0", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Run the tapes of all threads on a pool of n workers "
+            "(-1: number of cores; default: 0, one per thread)", // Help description.
+            "-tw", // Flag token.
+            "--tape-workers" // Flag token.
+    );
+    opt.add(
+            "0", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Generate live preprocessing for each tape up front according "
+            "to its compiled usage, in batches of up to n "
+            "(default: 0, disabled)", // Help description.
+            "-fc", // Flag token.
+            "--forecast" // Flag token.
+    );
+
+    opt.add(
+            "tree", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "How to open values with indirect communication "
+            "(tree, king, scatter; default: tree)\n\t"
+            "tree: sum and broadcast according to --opening-sum "
+            "and --max-broadcast if available\n\t"
+            "king: one party sums and broadcasts\n\t"
+            "scatter: every party sums and broadcasts a slice "
+            "(reduce-scatter and all-gather)", // Help description.
+            "-op", // Flag token.
+            "--opening" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Defer MAC checks to outputs and the end of tapes, checking "
+            "all values opened since in one round", // Help description.
+            "-lc", // Flag token.
+            "--lazy-mac-check" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Use matrix triples from files for secret matrix products "
+            "(all parties need to set this)", // Help description.
+            "-mt", // Flag token.
+            "--matrix-triples" // Flag token.
+    );
 
     opt.parse(argc, argv);
 
@@ -109,6 +214,25 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
         live_prep = opt.get("-L")->isSet;
     opt.get("-b")->getInt(batch_size);
     opt.get("--memory")->getString(memtype);
+    opt.get("--background-prep")->getInt(background_batches);
+    mapped_files = opt.isSet("--mmap-preprocessing");
+    event_loop = opt.isSet("--event-loop");
+    opt.get("--broadcast-hash")->getString(broadcast_hash);
+    BroadcastHash::default_type = BroadcastHash::parse(broadcast_hash.c_str());
+    opt.get("--tape-workers")->getInt(tape_workers);
+    opt.get("--forecast")->getInt(forecast_batch_size);
+    string opening_name;
+    opt.get("--opening")->getString(opening_name);
+    if (opening_name == "tree")
+        opening = TREE_OPENING;
+    else if (opening_name == "king")
+        opening = KING_OPENING;
+    else if (opening_name == "scatter")
+        opening = REDUCE_SCATTER_OPENING;
+    else
+        throw runtime_error("unknown opening: " + opening_name);
+    lazy_mac_check = opt.isSet("--lazy-mac-check");
+    matrix_triples = opt.isSet("--matrix-triples");
 
     opt.resetArgs();
 }
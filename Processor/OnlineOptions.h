@@ -8,6 +8,14 @@
 
 #include "Tools/ezOptionParser.h"
 
+// how TreeSum opens values with indirect communication
+enum OpeningMode
+{
+    TREE_OPENING,
+    KING_OPENING,
+    REDUCE_SCATTER_OPENING,
+};
+
 class OnlineOptions
 {
 public:
@@ -20,6 +28,15 @@ public:
     std::string progname;
     int batch_size;
     std::string memtype;
+    int background_batches;
+    bool mapped_files;
+    bool event_loop;
+    std::string broadcast_hash;
+    int tape_workers;
+    int forecast_batch_size;
+    OpeningMode opening;
+    bool lazy_mac_check;
+    bool matrix_triples;
 
     OnlineOptions();
     OnlineOptions(ez::ezOptionParser& opt, int argc, const char** argv,
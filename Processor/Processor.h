@@ -15,6 +15,7 @@
 #include "ExternalClients.h"
 #include "Binary_File_IO.h"
 #include "Instruction.h"
+#include "Memory.h"
 #include "ProcessorBase.h"
 #include "OnlineOptions.h"
 #include "Tools/SwitchableOutput.h"
@@ -61,6 +62,10 @@ public:
   void muls(const vector<int>& reg, int size);
   void mulrs(const vector<int>& reg);
   void dotprods(const vector<int>& reg, int size);
+  void matmuls(Memory<T>& source, const Instruction& instruction, int a,
+      int b);
+  void check_matmul(Memory<T>& source, const Instruction& instruction, int a,
+      int b);
 
   vector<T>& get_S()
   {
@@ -154,6 +159,8 @@ class Processor : public ArithmeticProcessor
   static const int reg_bytes = 4;
   
   void reset(const Program& program,int arg); // Reset the state of the processor
+  // Check MACs before output if deferred (--lazy-mac-check)
+  void check();
   string get_filename(const char* basename, bool use_number);
 
   Processor(int thread_num,Player& P,
@@ -193,6 +200,7 @@ class Processor : public ArithmeticProcessor
       { Procp.S[i]=x; }
 
   void dabit(const Instruction& instruction);
+  void edabit(const Instruction& instruction);
 
   // Access to external client sockets for reading clear/shared data
   void read_socket_ints(int client_id, const vector<int>& registers);
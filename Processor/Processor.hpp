@@ -102,6 +102,16 @@ void Processor<sint, sgf2n>::reset(const Program& program,int arg)
   Procb.reset(program);
 }
 
+template<class sint, class sgf2n>
+void Processor<sint, sgf2n>::check()
+{
+  if (OnlineOptions::singleton.lazy_mac_check)
+    {
+      MC2.Check(P);
+      MCp.Check(P);
+    }
+}
+
 template<class sint, class sgf2n>
 void Processor<sint, sgf2n>::dabit(const Instruction& instruction)
 {
@@ -117,6 +127,24 @@ void Processor<sint, sgf2n>::dabit(const Instruction& instruction)
   }
 }
 
+template<class sint, class sgf2n>
+void Processor<sint, sgf2n>::edabit(const Instruction& instruction)
+{
+  int size = instruction.get_size();
+  assert(size <= sint::bit_type::clear::n_bits);
+  auto& regs = instruction.get_start();
+  for (auto& reg : regs)
+    Procb.S[reg] = {};
+  vector<typename sint::bit_type> bits;
+  for (int i = 0; i < size; i++)
+  {
+    Procp.DataF.get_edabit(Procp.get_S_ref(instruction.get_r(0) + i), bits,
+        regs.size());
+    for (size_t j = 0; j < regs.size(); j++)
+      Procb.S[regs[j]] ^= bits[j] << i;
+  }
+}
+
 #include "Networking/sockets.h"
 #include "Math/Setup.h"
 
@@ -539,6 +567,43 @@ void SubProcessor<T>::dotprods(const vector<int>& reg, int size)
     }
 }
 
+template<class T>
+void SubProcessor<T>::check_matmul(Memory<T>& source,
+        const Instruction& instruction, int a, int b)
+{
+    auto& dim = instruction.get_start();
+    int n_rows = dim[0], n_inner = dim[1], n_cols = dim[2];
+    if (a < 0 or b < 0 or a + n_rows * n_inner > int(source.size_s())
+            or b + n_inner * n_cols > int(source.size_s()))
+        throw Processor_Error("matrix multiplication out of memory bounds");
+}
+
+template<class T>
+void SubProcessor<T>::matmuls(Memory<T>& source,
+        const Instruction& instruction, int a, int b)
+{
+    check_matmul(source, instruction, a, b);
+    auto& dim = instruction.get_start();
+    int n_rows = dim[0], n_inner = dim[1], n_cols = dim[2];
+
+    // one dot product per entry, so protocols with local dot products
+    // only communicate once per entry
+    auto A = &source.read_S(a);
+    auto B = &source.read_S(b);
+    protocol.init_dotprod(this);
+    for (int i = 0; i < n_rows; i++)
+        for (int j = 0; j < n_cols; j++)
+        {
+            for (int k = 0; k < n_inner; k++)
+                protocol.prepare_dotprod(A[i * n_inner + k],
+                        B[k * n_cols + j]);
+            protocol.next_dotprod();
+        }
+    protocol.exchange();
+    for (int i = 0; i < n_rows * n_cols; i++)
+        S[instruction.get_r(0) + i] = protocol.finalize_dotprod(n_inner);
+}
+
 template<class sint, class sgf2n>
 ostream& operator<<(ostream& s,const Processor<sint, sgf2n>& P)
 {
@@ -42,6 +42,51 @@ void Program::parse(istream& s)
       s.peek();
     }
   compute_constants();
+  decode();
+}
+
+void Program::decode()
+{
+  decoded.resize(p.size());
+  for (unsigned int i = 0; i < p.size(); i++)
+    {
+      auto& instr = p[i];
+      auto& d = decoded[i];
+      for (int j = 0; j < 3; j++)
+        d.r[j] = instr.get_r(j);
+      d.n = instr.get_n();
+      d.handler = DecodedInstruction::FALLBACK;
+      if (instr.get_size() != 1)
+        continue;
+      switch (instr.get_opcode())
+        {
+#define X(NAME) case NAME: d.handler = DecodedInstruction::NAME; break;
+        X(LDINT) X(ADDINT) X(SUBINT) X(MULINT) X(MOVINT)
+        X(EQZC) X(LTZC) X(LTC) X(GTC) X(EQC)
+        X(JMP) X(JMPNZ) X(JMPEQZ) X(PUSHINT) X(POPINT)
+#undef X
+        default:
+          break;
+        }
+    }
+
+  // fuse common pairs, the second instruction keeps its own entry
+  // in case it is a jump target
+  for (unsigned int i = 0; i + 1 < p.size(); i++)
+    {
+      auto& d = decoded[i];
+      auto next = decoded[i + 1].handler;
+      if (d.handler == DecodedInstruction::LDINT)
+        {
+          if (next == DecodedInstruction::ADDINT)
+            d.handler = DecodedInstruction::LDINT_ADDINT;
+          else if (next == DecodedInstruction::LTC)
+            d.handler = DecodedInstruction::LDINT_LTC;
+        }
+      else if (d.handler == DecodedInstruction::LTC
+          and next == DecodedInstruction::JMPNZ)
+        d.handler = DecodedInstruction::LTC_JMPNZ;
+    }
 }
 
 void Program::print_offline_cost() const
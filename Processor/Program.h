@@ -6,11 +6,38 @@
 
 template<class sint, class sgf2n> class Machine;
 
+// Handlers of the threaded interpreter, see Program::execute()
+#define DECODED_HANDLERS \
+  X(FALLBACK) X(LDINT) X(ADDINT) X(SUBINT) X(MULINT) X(MOVINT) \
+  X(EQZC) X(LTZC) X(LTC) X(GTC) X(EQC) \
+  X(JMP) X(JMPNZ) X(JMPEQZ) X(PUSHINT) X(POPINT) \
+  X(LDINT_ADDINT) X(LDINT_LTC) X(LTC_JMPNZ)
+
+/* Instruction pre-decoded for dispatch. Only scalar integer and control
+ * flow instructions get their own handler, everything else falls back
+ * to Instruction::execute(). Fused handlers read the operands of the
+ * second instruction from the following entry. */
+struct DecodedInstruction
+{
+  enum Handler
+  {
+#define X(NAME) NAME,
+    DECODED_HANDLERS
+#undef X
+  };
+
+  Handler handler;
+  int r[3];
+  int n;
+};
+
 /* A program is a vector of instructions */
 
 class Program
 {
   vector<Instruction> p;
+  // Same length as p, so that jumps can target any instruction
+  vector<DecodedInstruction> decoded;
   // Here we note the number of bits, squares and triples and input
   // data needed
   //  - This is computed for a whole program sequence to enable
@@ -27,6 +54,7 @@ class Program
   bool unknown_usage;
 
   void compute_constants();
+  void decode();
 
   public:
 
@@ -0,0 +1,92 @@
+/*
+ * BackgroundPrep.h
+ *
+ */
+
+#ifndef PROTOCOLS_BACKGROUNDPREP_H_
+#define PROTOCOLS_BACKGROUNDPREP_H_
+
+#include "Processor/Data_Files.h"
+
+#include <pthread.h>
+#include <deque>
+
+/*
+ * Live preprocessing where triples, squares, and bits are produced by
+ * a separate thread with its own communication channel. The thread keeps
+ * a bounded number of batches ahead of consumption. Everything else is
+ * delegated to the usual live preprocessing in the calling thread.
+ */
+template<class T>
+class BackgroundPrep : public Preprocessing<T>
+{
+    static const int STOP = 1 << N_DTYPE;
+
+    Preprocessing<T>& online_prep;
+    SubProcessor<T>* proc;
+
+    DataPositions producer_usage;
+    Player* producer_player;
+    typename T::MAC_Check* producer_MC;
+    Preprocessing<T>* producer_prep;
+    SubProcessor<T>* producer_proc;
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t produced, consumed;
+
+    deque<vector<T>> queues[N_DTYPE];
+    vector<T> current[N_DTYPE];
+    bool active[N_DTYPE];
+    size_t forecast_batches[N_DTYPE];
+    bool stopping, finished;
+    int thread_num;
+    size_t capacity;
+    size_t producer_sent;
+
+    static bool in_background(Dtype dtype);
+    static int player_id(int thread_num);
+    static void* run_thread(void* prep);
+
+    void start();
+    void stop();
+    void produce();
+    int wait_for_demand();
+    void produce_batch(Dtype dtype);
+    void get_from_background(Dtype dtype, T* a);
+
+public:
+    BackgroundPrep(SubProcessor<T>* proc, DataPositions& usage);
+    ~BackgroundPrep();
+
+    void set_protocol(typename T::Protocol& protocol);
+    void set_proc(SubProcessor<T>* proc);
+
+    void seekg(DataPositions& pos) { online_prep.seekg(pos); }
+    void prune() { online_prep.prune(); }
+    void purge() { online_prep.purge(); }
+
+    void forecast(const DataPositions& usage);
+
+    size_t data_sent();
+    NamedCommStats comm_stats() { return online_prep.comm_stats(); }
+
+    void get_three_no_count(Dtype dtype, T& a, T& b, T& c);
+    void get_two_no_count(Dtype dtype, T& a, T& b);
+    void get_one_no_count(Dtype dtype, T& a);
+    void get_input_no_count(T& a, typename T::open_type& x, int i)
+    { online_prep.get_input_no_count(a, x, i); }
+    void get_no_count(vector<T>& S, DataTag tag, const vector<int>& regs,
+            int vector_size)
+    { online_prep.get_no_count(S, tag, regs, vector_size); }
+
+    void get_dabit(T& a, typename T::bit_type& b) { online_prep.get_dabit(a, b); }
+    bool get_edabit_no_count(T& a, vector<typename T::bit_type>& bits,
+            int n_bits)
+    { return online_prep.get_edabit_no_count(a, bits, n_bits); }
+
+    void buffer_triples() { online_prep.buffer_triples(); }
+    void buffer_inverses() { online_prep.buffer_inverses(); }
+};
+
+#endif /* PROTOCOLS_BACKGROUNDPREP_H_ */
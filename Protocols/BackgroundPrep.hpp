@@ -0,0 +1,323 @@
+/*
+ * BackgroundPrep.hpp
+ *
+ */
+
+#ifndef PROTOCOLS_BACKGROUNDPREP_HPP_
+#define PROTOCOLS_BACKGROUNDPREP_HPP_
+
+#include "BackgroundPrep.h"
+#include "Processor/Processor.h"
+#include "Processor/BaseMachine.h"
+#include "Processor/OnlineOptions.h"
+#include "Networking/CryptoPlayer.h"
+
+template<class T>
+BackgroundPrep<T>::BackgroundPrep(SubProcessor<T>* proc, DataPositions& usage) :
+        Preprocessing<T>(usage),
+        online_prep(*Preprocessing<T>::get_live_prep(proc, usage)), proc(proc),
+        producer_usage(usage.num_players()), producer_player(0),
+        producer_MC(0), producer_prep(0), producer_proc(0),
+        stopping(false), finished(true), thread_num(0), producer_sent(0)
+{
+    pthread_mutex_init(&mutex, 0);
+    pthread_cond_init(&produced, 0);
+    pthread_cond_init(&consumed, 0);
+    for (int i = 0; i < N_DTYPE; i++)
+    {
+        active[i] = false;
+        forecast_batches[i] = 0;
+    }
+    capacity = max(1, OnlineOptions::singleton.background_batches);
+}
+
+template<class T>
+BackgroundPrep<T>::~BackgroundPrep()
+{
+    stop();
+    if (producer_proc)
+    {
+        delete producer_proc;
+        delete producer_prep;
+        delete producer_MC;
+        delete producer_player;
+    }
+    delete &online_prep;
+    pthread_mutex_destroy(&mutex);
+    pthread_cond_destroy(&produced);
+    pthread_cond_destroy(&consumed);
+}
+
+template<class T>
+bool BackgroundPrep<T>::in_background(Dtype dtype)
+{
+    switch (dtype)
+    {
+    case DATA_TRIPLE:
+    case DATA_SQUARE:
+    case DATA_BIT:
+        return T::clear::allows(dtype);
+    default:
+        return false;
+    }
+}
+
+template<class T>
+int BackgroundPrep<T>::player_id(int thread_num)
+{
+    // distinct from online threads and MAC check channels
+    return (5 << 28) + ((T::field_type() + 1) << 24) + (thread_num << 16);
+}
+
+template<class T>
+void BackgroundPrep<T>::set_proc(SubProcessor<T>* proc)
+{
+    this->proc = proc;
+    online_prep.set_proc(proc);
+}
+
+template<class T>
+void BackgroundPrep<T>::set_protocol(typename T::Protocol& protocol)
+{
+    online_prep.set_protocol(protocol);
+    if (producer_proc == 0)
+        start();
+}
+
+template<class T>
+void BackgroundPrep<T>::start()
+{
+    assert(proc != 0);
+    thread_num = BaseMachine::thread_num;
+    auto& P = proc->P;
+
+    // all parties set up the producer in the same order,
+    // so the connections can be made synchronously
+    if (P.is_encrypted())
+        producer_player = new CryptoPlayer(P.N, player_id(thread_num));
+    else
+        producer_player = new PlainPlayer(P.N, player_id(thread_num));
+    producer_MC = new typename T::MAC_Check(proc->MC.get_alphai());
+    producer_prep = Preprocessing<T>::get_live_prep(0, producer_usage);
+    producer_proc = new SubProcessor<T>(*producer_MC, *producer_prep,
+            *producer_player);
+
+    finished = false;
+    pthread_create(&thread, 0, run_thread, this);
+}
+
+template<class T>
+void BackgroundPrep<T>::stop()
+{
+    if (producer_proc == 0)
+        return;
+    pthread_mutex_lock(&mutex);
+    stopping = true;
+    pthread_cond_signal(&consumed);
+    pthread_mutex_unlock(&mutex);
+    pthread_join(thread, 0);
+}
+
+template<class T>
+void* BackgroundPrep<T>::run_thread(void* prep)
+{
+    ((BackgroundPrep<T>*) prep)->produce();
+    return 0;
+}
+
+template<class T>
+void BackgroundPrep<T>::produce()
+{
+    bigint::init_thread();
+    BaseMachine::thread_num = thread_num;
+    auto& P = *producer_player;
+
+    try
+    {
+        while (true)
+        {
+            // parties have to agree on what to produce next
+            vector<octetStream> os(P.num_players());
+            os[P.my_num()].store(wait_for_demand());
+            P.Broadcast_Receive(os, true);
+            int demand = 0;
+            for (auto& o : os)
+            {
+                int x;
+                o.get(x);
+                demand |= x;
+            }
+
+            if (demand & STOP)
+                break;
+
+            for (int dtype = 0; dtype < N_DTYPE; dtype++)
+                if (demand & (1 << dtype))
+                    produce_batch(Dtype(dtype));
+        }
+
+        producer_MC->Check(P);
+        P.Check_Broadcast();
+    }
+    catch (exception& e)
+    {
+        cerr << "Background preprocessing failed: " << e.what() << endl;
+    }
+
+    pthread_mutex_lock(&mutex);
+    finished = true;
+    producer_sent = P.sent + producer_prep->data_sent();
+    pthread_cond_broadcast(&produced);
+    pthread_mutex_unlock(&mutex);
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    OPENSSL_thread_stop();
+#endif
+}
+
+template<class T>
+int BackgroundPrep<T>::wait_for_demand()
+{
+    int demand;
+    pthread_mutex_lock(&mutex);
+    while (true)
+    {
+        demand = stopping ? STOP : 0;
+        for (int dtype = 0; dtype < N_DTYPE; dtype++)
+            if (active[dtype]
+                    and queues[dtype].size()
+                            < max(capacity, forecast_batches[dtype]))
+                demand |= 1 << dtype;
+        if (demand)
+            break;
+        pthread_cond_wait(&consumed, &mutex);
+    }
+    pthread_mutex_unlock(&mutex);
+    return demand;
+}
+
+template<class T>
+void BackgroundPrep<T>::produce_batch(Dtype dtype)
+{
+    int tuple_size = DataPositions::tuple_size[dtype];
+    int batch_size = OnlineOptions::singleton.batch_size;
+    vector<T> batch(batch_size * tuple_size);
+    for (int i = 0; i < batch_size; i++)
+        producer_prep->get(dtype, &batch[i * tuple_size]);
+
+    pthread_mutex_lock(&mutex);
+    queues[dtype].push_back({});
+    queues[dtype].back().swap(batch);
+    producer_sent = producer_player->sent + producer_prep->data_sent();
+    pthread_cond_signal(&produced);
+    pthread_mutex_unlock(&mutex);
+}
+
+template<class T>
+void BackgroundPrep<T>::get_from_background(Dtype dtype, T* a)
+{
+    auto& buffer = current[dtype];
+    if (buffer.empty())
+    {
+        pthread_mutex_lock(&mutex);
+        active[dtype] = true;
+        while (queues[dtype].empty() and not finished)
+        {
+            pthread_cond_signal(&consumed);
+            pthread_cond_wait(&produced, &mutex);
+        }
+        if (queues[dtype].empty())
+        {
+            pthread_mutex_unlock(&mutex);
+            throw runtime_error("background preprocessing terminated");
+        }
+        buffer.swap(queues[dtype].front());
+        queues[dtype].pop_front();
+        if (forecast_batches[dtype] > 0)
+            forecast_batches[dtype]--;
+        pthread_cond_signal(&consumed);
+        pthread_mutex_unlock(&mutex);
+    }
+
+    int tuple_size = DataPositions::tuple_size[dtype];
+    for (int i = 0; i < tuple_size; i++)
+        a[i] = buffer[buffer.size() - tuple_size + i];
+    buffer.resize(buffer.size() - tuple_size);
+}
+
+template<class T>
+void BackgroundPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
+{
+    if (not in_background(dtype))
+        return online_prep.get_three_no_count(dtype, a, b, c);
+
+    T tuple[3];
+    get_from_background(dtype, tuple);
+    a = tuple[0];
+    b = tuple[1];
+    c = tuple[2];
+}
+
+template<class T>
+void BackgroundPrep<T>::get_two_no_count(Dtype dtype, T& a, T& b)
+{
+    if (not in_background(dtype))
+        return online_prep.get_two_no_count(dtype, a, b);
+
+    T tuple[2];
+    get_from_background(dtype, tuple);
+    a = tuple[0];
+    b = tuple[1];
+}
+
+template<class T>
+void BackgroundPrep<T>::get_one_no_count(Dtype dtype, T& a)
+{
+    if (not in_background(dtype))
+        return online_prep.get_one_no_count(dtype, a);
+
+    get_from_background(dtype, &a);
+}
+
+template<class T>
+void BackgroundPrep<T>::forecast(const DataPositions& usage)
+{
+    // background types: let the producer run further ahead
+    DataPositions rest = usage;
+    auto& files = rest.files[T::field_type()];
+    int batch_size = OnlineOptions::singleton.batch_size;
+    pthread_mutex_lock(&mutex);
+    for (int dtype = 0; dtype < N_DTYPE; dtype++)
+        if (in_background(Dtype(dtype)))
+        {
+            long long n_missing = files[dtype]
+                    - current[dtype].size() / DataPositions::tuple_size[dtype];
+            for (auto& batch : queues[dtype])
+                n_missing -= batch.size() / DataPositions::tuple_size[dtype];
+            if (n_missing > 0)
+            {
+                // same limit as forecasting in the online thread
+                n_missing = min(n_missing,
+                        (long long) OnlineOptions::singleton.forecast_batch_size);
+                active[dtype] = true;
+                forecast_batches[dtype] = queues[dtype].size()
+                        + DIV_CEIL(n_missing, batch_size);
+            }
+            files[dtype] = 0;
+        }
+    pthread_cond_signal(&consumed);
+    pthread_mutex_unlock(&mutex);
+
+    online_prep.forecast(rest);
+}
+
+template<class T>
+size_t BackgroundPrep<T>::data_sent()
+{
+    pthread_mutex_lock(&mutex);
+    size_t res = producer_sent;
+    pthread_mutex_unlock(&mutex);
+    return res + online_prep.data_sent();
+}
+
+#endif /* PROTOCOLS_BACKGROUNDPREP_HPP_ */
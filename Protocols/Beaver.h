@@ -44,6 +44,9 @@ public:
     void start_exchange();
     void stop_exchange();
 
+    void matmuls(Memory<T>& source, const Instruction& instruction, int a,
+            int b, SubProcessor<T>& proc);
+
     int get_n_relevant_players() { return 1 + T::threshold(P.num_players()); }
 };
 
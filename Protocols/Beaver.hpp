@@ -80,4 +80,53 @@ T Beaver<T>::finalize_mul(int n)
     return tmp;
 }
 
+template<class T>
+void Beaver<T>::matmuls(Memory<T>& source, const Instruction& instruction,
+        int a, int b, SubProcessor<T>& proc)
+{
+    auto& dim = instruction.get_start();
+    array<int, 3> dims = {{dim[0], dim[1], dim[2]}};
+    if (not proc.DataF.has_matrix_triples(dims))
+    {
+        ProtocolBase<T>::matmuls(source, instruction, a, b, proc);
+        return;
+    }
+
+    // with a matrix triple C = A * B, only A - X and B - Y are opened
+    proc.check_matmul(source, instruction, a, b);
+    int n_rows = dim[0], n_inner = dim[1], n_cols = dim[2];
+    auto A = &source.read_S(a);
+    auto B = &source.read_S(b);
+    auto triple = proc.DataF.get_matrix_triple(dims);
+    auto& X = triple[0];
+    auto& Y = triple[1];
+    auto& Z = triple[2];
+    shares.clear();
+    for (int i = 0; i < n_rows * n_inner; i++)
+        shares.push_back(A[i] - X[i]);
+    for (int i = 0; i < n_inner * n_cols; i++)
+        shares.push_back(B[i] - Y[i]);
+    proc.MC.POpen(opened, shares, P);
+
+    auto E = opened.begin();
+    auto F = opened.begin() + n_rows * n_inner;
+    for (int i = 0; i < n_rows; i++)
+        for (int j = 0; j < n_cols; j++)
+        {
+            T res = Z[i * n_cols + j];
+            typename T::clear masked_product;
+            for (int k = 0; k < n_inner; k++)
+            {
+                typename T::clear e = E[i * n_inner + k];
+                typename T::clear f = F[k * n_cols + j];
+                res += e * Y[k * n_cols + j] + f * X[i * n_inner + k];
+                masked_product += e * f;
+            }
+            res += T::constant(masked_product, P.my_num(),
+                    proc.MC.get_alphai());
+            proc.S[instruction.get_r(0) + i * n_cols + j] = res;
+        }
+    this->counter += n_rows * n_inner * n_cols;
+}
+
 #endif
@@ -4,6 +4,7 @@
  */
 
 #include "CowGearOptions.h"
+#include "FHEOffline/ProofThreads.h"
 #include "Tools/benchmarking.h"
 
 #include <math.h>
@@ -46,6 +47,15 @@ CowGearOptions::CowGearOptions(ez::ezOptionParser& opt, int argc,
             "-l", // Flag token.
             "--lowgear-security" // Flag token.
     );
+    opt.add(
+            "1", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Number of threads per zero-knowledge proof (default: 1)", // Help description.
+            "-pt", // Flag token.
+            "--proof-threads" // Flag token.
+    );
     opt.parse(argc, argv);
     if (opt.isSet("-c"))
         opt.get("-c")->getInt(covert_security);
@@ -63,5 +73,6 @@ CowGearOptions::CowGearOptions(ez::ezOptionParser& opt, int argc,
     }
     else
         lowgear_from_covert();
+    opt.get("-pt")->getInt(ProofThreads::n_threads);
     opt.resetArgs();
 }
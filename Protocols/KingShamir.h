@@ -0,0 +1,80 @@
+/*
+ * KingShamir.h
+ *
+ */
+
+#ifndef PROTOCOLS_KINGSHAMIR_H_
+#define PROTOCOLS_KINGSHAMIR_H_
+
+#include <vector>
+#include <array>
+using namespace std;
+
+#include "Replicated.h"
+#include "Shamir.h"
+
+/*
+ * Multiplication for Shamir's secret sharing by Damgård and Nielsen
+ * (https://eprint.iacr.org/2006/035): parties mask the degree-2t product
+ * with a double sharing ([r]_t, [r]_2t), one king per product opens the
+ * masked value and sends it back to everyone, and [r]_t plus the opened
+ * value is the result. This costs O(n) elements per product instead of
+ * O(n^2) for resharing, and the king rotates between products.
+ */
+template<class T>
+class KingShamir : public ProtocolBase<T>
+{
+    typedef typename T::clear clear;
+
+    Shamir<clear> shamir;
+
+    vector<octetStream> send_os, receive_os;
+    vector<T> masks;
+    vector<array<T, 2>> double_randoms;
+    vector<vector<clear>> vandermonde, extraction;
+
+    clear rec_factor;
+    clear dotprod_share;
+
+    SeededPRNG secure_prng;
+
+    int threshold;
+    int n_mul_players;
+
+    int first_king, next_king;
+    int n_products, n_mine, n_finalized;
+
+    void exchange_from_first(vector<octetStream>& to_send,
+            vector<octetStream>& to_receive, int n_senders);
+
+    void buffer_double_random();
+    array<T, 2> get_double_random();
+
+    void add_product(const clear& product);
+
+public:
+    static const bool uses_triples = false;
+
+    Player& P;
+
+    KingShamir(Player& P);
+
+    KingShamir branch();
+
+    int get_n_relevant_players();
+
+    void init_mul();
+    void init_mul(SubProcessor<T>* proc);
+    clear prepare_mul(const T& x, const T& y, int n = -1);
+    void exchange();
+    T finalize_mul(int n = -1);
+
+    void init_dotprod(SubProcessor<T>* proc);
+    void prepare_dotprod(const T& x, const T& y);
+    void next_dotprod();
+    T finalize_dotprod(int length);
+
+    T get_random();
+};
+
+#endif /* PROTOCOLS_KINGSHAMIR_H_ */
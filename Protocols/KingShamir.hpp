@@ -0,0 +1,226 @@
+/*
+ * KingShamir.hpp
+ *
+ */
+
+#ifndef PROTOCOLS_KINGSHAMIR_HPP_
+#define PROTOCOLS_KINGSHAMIR_HPP_
+
+#include "KingShamir.h"
+#include "ShamirInput.h"
+#include "Machines/ShamirMachine.h"
+
+template<class T>
+KingShamir<T>::KingShamir(Player& P) :
+        shamir(P), first_king(0), next_king(0), n_products(0), n_mine(0),
+        n_finalized(0), P(P)
+{
+    threshold = ShamirMachine::s().threshold;
+    n_mul_players = 2 * threshold + 1;
+    if (P.my_num() < n_mul_players)
+        rec_factor = Shamir<clear>::get_rec_factor(P.my_num(), n_mul_players);
+}
+
+template<class T>
+KingShamir<T> KingShamir<T>::branch()
+{
+    return P;
+}
+
+template<class T>
+int KingShamir<T>::get_n_relevant_players()
+{
+    return threshold + 1;
+}
+
+template<class T>
+void KingShamir<T>::exchange_from_first(vector<octetStream>& to_send,
+        vector<octetStream>& to_receive, int n_senders)
+{
+    int n = P.num_players();
+    vector<vector<bool>> channels(n, vector<bool>(n));
+    for (int i = 0; i < n_senders; i++)
+        channels[i].assign(n, true);
+    P.send_receive_all(channels, to_send, to_receive);
+}
+
+template<class T>
+void KingShamir<T>::buffer_double_random()
+{
+    int n = P.num_players();
+    int n_out = n - threshold;
+    int buffer_size = DIV_CEIL(OnlineOptions::singleton.batch_size, n_out);
+    if (vandermonde.empty())
+    {
+        vandermonde = ShamirInput<T>::get_vandermonde(2 * threshold, n);
+        extraction = Shamir<clear>::get_extraction_matrix(n, threshold);
+    }
+    auto& matrix = extraction;
+
+    // all parties deal, and extraction results in n - t double sharings
+    vector<octetStream> to_send(n), to_receive;
+    vector<array<T, 2>> mine;
+    vector<clear> coefficients(3 * threshold);
+    for (int k = 0; k < buffer_size; k++)
+    {
+        clear secret = secure_prng.get<clear>();
+        for (auto& x : coefficients)
+            x.randomize(secure_prng);
+        for (int i = 0; i < n; i++)
+        {
+            array<T, 2> shares = {{ secret, secret }};
+            for (int j = 0; j < threshold; j++)
+                shares[0] += coefficients[j] * vandermonde[i][j];
+            for (int j = 0; j < 2 * threshold; j++)
+                shares[1] += coefficients[threshold + j] * vandermonde[i][j];
+            if (i == P.my_num())
+                mine.push_back(shares);
+            else
+                for (auto& share : shares)
+                    share.pack(to_send[i]);
+        }
+    }
+
+    exchange_from_first(to_send, to_receive, n);
+
+    vector<array<T, 2>> dealt(n);
+    for (int k = 0; k < buffer_size; k++)
+    {
+        for (int i = 0; i < n; i++)
+            if (i == P.my_num())
+                dealt[i] = mine[k];
+            else
+                for (auto& share : dealt[i])
+                    share = to_receive[i].get<T>();
+        for (int l = 0; l < n_out; l++)
+        {
+            array<T, 2> sum = {};
+            for (int i = 0; i < n; i++)
+                for (int j = 0; j < 2; j++)
+                    sum[j] += dealt[i][j] * matrix[l][i];
+            double_randoms.push_back(sum);
+        }
+    }
+}
+
+template<class T>
+array<T, 2> KingShamir<T>::get_double_random()
+{
+    if (double_randoms.empty())
+        buffer_double_random();
+    auto res = double_randoms.back();
+    double_randoms.pop_back();
+    return res;
+}
+
+template<class T>
+void KingShamir<T>::init_mul(SubProcessor<T>* proc)
+{
+    (void) proc;
+    init_mul();
+}
+
+template<class T>
+void KingShamir<T>::init_mul()
+{
+    send_os.clear();
+    send_os.resize(P.num_players());
+    masks.clear();
+    first_king = next_king;
+    n_products = 0;
+    n_mine = 0;
+    n_finalized = 0;
+}
+
+template<class T>
+void KingShamir<T>::add_product(const clear& product)
+{
+    auto double_random = get_double_random();
+    masks.push_back(double_random[0]);
+    int king = (first_king + n_products++) % P.num_players();
+    if (king == P.my_num())
+        n_mine++;
+    // the king only has to add what it receives
+    if (P.my_num() < n_mul_players)
+        ((product - double_random[1]) * rec_factor).pack(send_os[king]);
+}
+
+template<class T>
+typename T::clear KingShamir<T>::prepare_mul(const T& x, const T& y, int n)
+{
+    (void) n;
+    clear product = x * y;
+    add_product(product);
+    return product;
+}
+
+template<class T>
+void KingShamir<T>::exchange()
+{
+    exchange_from_first(send_os, receive_os, n_mul_players);
+    if (P.my_num() < n_mul_players)
+    {
+        receive_os[P.my_num()] = send_os[P.my_num()];
+        receive_os[P.my_num()].reset_read_head();
+    }
+
+    // open masked products as king
+    vector<octetStream> opened(P.num_players());
+    for (int k = 0; k < n_mine; k++)
+    {
+        clear sum;
+        for (int i = 0; i < n_mul_players; i++)
+            sum += receive_os[i].get<clear>();
+        sum.pack(opened[P.my_num()]);
+    }
+
+    P.Broadcast_Receive(opened, true);
+    receive_os = opened;
+    for (auto& os : receive_os)
+        os.reset_read_head();
+    next_king = (first_king + n_products) % P.num_players();
+}
+
+template<class T>
+T KingShamir<T>::finalize_mul(int n)
+{
+    (void) n;
+    int king = (first_king + n_finalized) % P.num_players();
+    return masks[n_finalized++]
+            + T::constant(receive_os[king].get<clear>(), P.my_num());
+}
+
+template<class T>
+void KingShamir<T>::init_dotprod(SubProcessor<T>* proc)
+{
+    init_mul(proc);
+    dotprod_share = 0;
+}
+
+template<class T>
+void KingShamir<T>::prepare_dotprod(const T& x, const T& y)
+{
+    dotprod_share += x * y;
+}
+
+template<class T>
+void KingShamir<T>::next_dotprod()
+{
+    add_product(dotprod_share);
+    dotprod_share = 0;
+}
+
+template<class T>
+T KingShamir<T>::finalize_dotprod(int length)
+{
+    (void) length;
+    return finalize_mul();
+}
+
+template<class T>
+T KingShamir<T>::get_random()
+{
+    return shamir.get_random();
+}
+
+#endif /* PROTOCOLS_KINGSHAMIR_HPP_ */
@@ -0,0 +1,37 @@
+/*
+ * KingShamirShare.h
+ *
+ */
+
+#ifndef PROTOCOLS_KINGSHAMIRSHARE_H_
+#define PROTOCOLS_KINGSHAMIRSHARE_H_
+
+#include "ShamirShare.h"
+#include "KingShamir.h"
+
+template<class T>
+class KingShamirShare : public ShamirShare<T>
+{
+    typedef ShamirShare<T> super;
+
+public:
+    typedef KingShamir<KingShamirShare> Protocol;
+    typedef ShamirMC<KingShamirShare> MAC_Check;
+    typedef MAC_Check Direct_MC;
+    typedef ShamirInput<KingShamirShare> Input;
+    typedef ::PrivateOutput<KingShamirShare> PrivateOutput;
+    typedef ReplicatedPrep<KingShamirShare> LivePrep;
+    typedef KingShamirShare Honest;
+
+    KingShamirShare()
+    {
+    }
+    template<class U>
+    KingShamirShare(const U& other, int my_num = 0, T alphai = {}) :
+            super(other)
+    {
+        (void) my_num, (void) alphai;
+    }
+};
+
+#endif /* PROTOCOLS_KINGSHAMIRSHARE_H_ */
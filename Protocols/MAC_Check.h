@@ -12,6 +12,7 @@ using namespace std;
 #include "Protocols/Summer.h"
 #include "Protocols/MAC_Check_Base.h"
 #include "Protocols/RandomPrep.h"
+#include "Processor/OnlineOptions.h"
 #include "Tools/time-func.h"
 
 
@@ -24,6 +25,11 @@ using namespace std;
  */
 #define POPEN_MAX 1000000
 
+/* Bound on the values kept for a lazy check (--lazy-mac-check)
+ * between explicit checks
+ */
+#define LAZY_POPEN_MAX (16 * POPEN_MAX)
+
 
 template <class T>
 void write_mac_key(string& dir, int my_num, const T& key);
@@ -40,9 +46,14 @@ protected:
   int base_player;
   int opening_sum;
   int max_broadcast;
+  OpeningMode mode;
   octetStream os;
+  // slices for the other players when reduce-scattering
+  vector<octetStream> slices;
 
   void ReceiveValues(vector<T>& values, const Player& P, int sender);
+  void start_reduce_scatter(vector<T>& values, const Player& P);
+  void finish_reduce_scatter(vector<T>& values, const Player& P);
   virtual void AddToValues(vector<T>& values) { (void)values; }
   virtual void GetValues(vector<T>& values) { (void)values; }
 
@@ -76,6 +87,9 @@ class MAC_Check_ : public TreeSum<typename U::open_type>, public MAC_Check_Base<
   vector<typename U::mac_type> macs;
   vector<T> vals;
 
+  // only check at outputs and the end of tapes
+  bool lazy;
+
   virtual void AddToMacs(const vector<U>& shares);
   virtual void PrepareSending(vector<T>& values,const vector<U>& S);
   void AddToValues(vector<T>& values);
@@ -219,7 +233,8 @@ enum mc_timer { SEND, RECV_ADD, BCAST, RECV_SUM, SEED, COMMIT, WAIT_SUMMER, RECV
 
 template<class T>
 TreeSum<T>::TreeSum(int opening_sum, int max_broadcast, int base_player) :
-    base_player(base_player), opening_sum(opening_sum), max_broadcast(max_broadcast)
+    base_player(base_player), opening_sum(opening_sum), max_broadcast(max_broadcast),
+    mode(OnlineOptions::singleton.opening)
 {
   timers.resize(MAX_TIMER);
 }
@@ -298,9 +313,92 @@ void add_openings(vector<T>& values, const Player& P, int sum_players, int last_
     }
 }
 
+// slice of values summed and broadcast by player i when reduce-scattering
+inline size_t slice_begin(size_t n_values, int i, int n_players)
+{
+  return n_values * i / n_players;
+}
+
+template<class T, int t>
+void add_slice(vector<T>& values, octetStream& os, size_t begin, size_t end)
+{
+  if ((unsigned)os.get_length() < (end - begin) * T::size())
+    {
+      stringstream ss;
+      ss << "Not enough information received, expected "
+          << (end - begin) * T::size() << " bytes, got "
+          << os.get_length();
+      throw Processor_Error(ss.str());
+    }
+  for (size_t i = begin; i < end; i++)
+    values[i].template add<t>(os);
+}
+
+template<class T>
+void TreeSum<T>::start_reduce_scatter(vector<T>& values, const Player& P)
+{
+  int n = P.num_players();
+  int me = P.my_num();
+  size_t begin = slice_begin(values.size(), me, n);
+  size_t end = slice_begin(values.size(), me + 1, n);
+  slices.resize(n);
+  for (int j = 0; j < n; j++)
+    if (j != me)
+      {
+        slices[j].reset_write_head();
+        for (size_t i = slice_begin(values.size(), j, n);
+            i < slice_begin(values.size(), j + 1, n); i++)
+          values[i].pack(slices[j]);
+      }
+  // all slices in one round
+  vector<vector<bool>> channels(n, vector<bool>(n, true));
+  timers[RECV_ADD].start();
+  P.send_receive_all(channels, slices, oss);
+  timers[SUM].start();
+  for (int j = 0; j < n; j++)
+    if (j != me)
+      {
+        if (T::t() == 2)
+          add_slice<T,2>(values, oss[j], begin, end);
+        else
+          add_slice<T,0>(values, oss[j], begin, end);
+      }
+  timers[SUM].stop();
+  timers[RECV_ADD].stop();
+}
+
+template<class T>
+void TreeSum<T>::finish_reduce_scatter(vector<T>& values, const Player& P)
+{
+  int n = P.num_players();
+  int me = P.my_num();
+  oss.resize(n);
+  oss[me].reset_write_head();
+  for (size_t i = slice_begin(values.size(), me, n);
+      i < slice_begin(values.size(), me + 1, n); i++)
+    values[i].pack(oss[me]);
+  timers[BCAST].start();
+  P.Broadcast_Receive(oss, true);
+  timers[BCAST].stop();
+  for (int j = 0; j < n; j++)
+    if (j != me)
+      for (size_t i = slice_begin(values.size(), j, n);
+          i < slice_begin(values.size(), j + 1, n); i++)
+        values[i].unpack(oss[j]);
+  AddToValues(values);
+}
+
 template<class T>
 void TreeSum<T>::start(vector<T>& values, const Player& P)
 {
+  if (mode == REDUCE_SCATTER_OPENING)
+    {
+      start_reduce_scatter(values, P);
+      return;
+    }
+  if (mode == KING_OPENING)
+    opening_sum = max_broadcast = P.num_players();
+
   os.reset_write_head();
   int sum_players = P.num_players();
   int my_relative_num = positive_modulo(P.my_num() - base_player, P.num_players());
@@ -365,6 +463,11 @@ void TreeSum<T>::start(vector<T>& values, const Player& P)
 template<class T>
 void TreeSum<T>::finish(vector<T>& values, const Player& P)
 {
+  if (mode == REDUCE_SCATTER_OPENING)
+    {
+      finish_reduce_scatter(values, P);
+      return;
+    }
   int my_relative_num = positive_modulo(P.my_num() - base_player, P.num_players());
   if (my_relative_num * max_broadcast >= P.num_players())
     {
@@ -10,6 +10,7 @@
 #include "Tools/int.h"
 #include "Tools/benchmarking.h"
 #include "Tools/Bundle.h"
+#include "Math/VectorKernels.h"
 
 #include <algorithm>
 
@@ -32,7 +33,8 @@ const char* TreeSum<T>::mc_timer_names[] = {
 template<class U>
 MAC_Check_<U>::MAC_Check_(const typename U::mac_key_type::Scalar& ai, int opening_sum,
     int max_broadcast, int send_player) :
-    TreeSum<T>(opening_sum, max_broadcast, send_player)
+    TreeSum<T>(opening_sum, max_broadcast, send_player),
+    lazy(OnlineOptions::singleton.lazy_mac_check)
 {
   popen_cnt=0;
   this->alphai=ai;
@@ -126,7 +128,7 @@ void MAC_Check_<U>::GetValues(vector<T>& values)
 template<class T>
 void MAC_Check_<T>::CheckIfNeeded(const Player& P)
 {
-  if (WaitingForCheck() >= POPEN_MAX)
+  if (WaitingForCheck() >= (lazy ? LAZY_POPEN_MAX : POPEN_MAX))
     Check(P);
 }
 
@@ -175,24 +177,37 @@ void MAC_Check_<U>::Check(const Player& P)
     {
       octet seed[SEED_SIZE];
       this->timers[SEED].start();
-      Create_Random_Seed(seed,P,SEED_SIZE);
+      // With lazy checking, derive the coefficients from all opened
+      // values, which are fixed by now, and save a commitment round.
+      // Only do so if the field is large enough to prevent grinding.
+      if (lazy and U::mac_type::Scalar::size_in_bits() >= 128)
+        {
+          octetStream os;
+          for (int i = 0; i < popen_cnt; i++)
+            vals[i].pack(os);
+          memcpy(seed, os.hash().get_data(), SEED_SIZE);
+        }
+      else
+        Create_Random_Seed(seed,P,SEED_SIZE);
       this->timers[SEED].stop();
       PRNG G;
       G.SetSeed(seed);
 
-      U sj;
+      typedef VectorKernels<typename U::mac_type> kernels;
       typename U::mac_type a,gami,temp;
-      typename U::mac_type::Scalar h;
+      vector<typename U::mac_type::Scalar> h(min(popen_cnt, 1024));
       vector<typename U::mac_type> tau(P.num_players());
       a.assign_zero();
       gami.assign_zero();
-      for (int i=0; i<popen_cnt; i++)
+      // coefficients in chunks for batched multiply-accumulate
+      for (int i=0; i<popen_cnt; i+=h.size())
         {
-          h.almost_randomize(G);
-          temp = vals[i] * h;
+          int n = min(int(h.size()), popen_cnt - i);
+          for (int j = 0; j < n; j++)
+            h[j].almost_randomize(G);
+          temp = kernels::inner_product(&vals[i], h.data(), n);
           a.add(a,temp);
-
-          temp.mul(h,macs[i]);
+          temp = kernels::inner_product(&macs[i], h.data(), n);
           gami.add(gami,temp);
         }
 
@@ -398,6 +413,8 @@ Parallel_MAC_Check<T>::Parallel_MAC_Check(const T& ai, Names& Nms,
     send_player(Nms, mc_base_id<T>(2, thread_num)),
     send_base_player(base_player)
 {
+  // the summer threads implement the tree
+  this->mode = TREE_OPENING;
   int sum_players = Nms.num_players();
   Player* summer_send_player = &send_player;
   for (int i = 0; ; i++)
@@ -567,6 +584,8 @@ template<class T>
 Passing_MAC_Check<T>::Passing_MAC_Check(const T& ai, Names& Nms, int num) :
   Separate_MAC_Check<Share<T>>(ai, Nms, num)
 {
+  // only the final broadcast uses TreeSum
+  this->mode = TREE_OPENING;
 }
 
 template<class T, int t>
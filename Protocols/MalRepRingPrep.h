@@ -21,6 +21,13 @@ public:
     void buffer_squares();
 
     void buffer_inputs(int player);
+
+    bool get_edabit_no_count(T& a, vector<typename T::bit_type>& bits,
+            int n_bits)
+    {
+        this->get_edabit_from_adder(a, bits, n_bits);
+        return true;
+    }
 };
 
 // extra class to avoid recursion
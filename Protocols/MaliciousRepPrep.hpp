@@ -53,7 +53,7 @@ template<class T>
 void MaliciousRepPrep<T>::buffer_triples()
 {
     auto& triples = this->triples;
-    auto buffer_size = OnlineOptions::singleton.batch_size;
+    auto buffer_size = this->buffer_size;
     clear_tmp();
     Player& P = honest_prep.protocol->P;
     check_triples.clear();
@@ -112,7 +112,7 @@ template<class T>
 void MaliciousRepPrep<T>::buffer_squares()
 {
     auto& squares = this->squares;
-    auto buffer_size = OnlineOptions::singleton.batch_size;
+    auto buffer_size = this->buffer_size;
     clear_tmp();
     Player& P = honest_prep.protocol->P;
     squares.clear();
@@ -156,7 +156,7 @@ template<class T>
 void MaliciousRepPrep<T>::buffer_bits()
 {
     auto& bits = this->bits;
-    auto buffer_size = OnlineOptions::singleton.batch_size;
+    auto buffer_size = this->buffer_size;
     clear_tmp();
     Player& P = honest_prep.protocol->P;
     bits.clear();
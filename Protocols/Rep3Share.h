@@ -8,6 +8,7 @@
 
 #include "Math/FixedVec.h"
 #include "Math/Integer.h"
+#include "Math/VectorKernels.h"
 #include "Protocols/Replicated.h"
 #include "GC/ShareSecret.h"
 
@@ -135,4 +136,17 @@ public:
     }
 };
 
+template<class T>
+struct ring_words<Rep3Share<T>>
+{
+    static const int value = 2 * ring_words<T>::value;
+    static const int n_bits = ring_words<T>::n_bits;
+};
+
+template<class T>
+struct gf2n_words<Rep3Share<T>>
+{
+    static const int value = 2 * gf2n_words<T>::value;
+};
+
 #endif /* PROTOCOLS_REP3SHARE_H_ */
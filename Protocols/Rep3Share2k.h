@@ -37,4 +37,9 @@ public:
     }
 };
 
+template<int K>
+struct ring_words<Rep3Share2<K>> : ring_words<Rep3Share<SignedZ2<K>>>
+{
+};
+
 #endif /* PROTOCOLS_REP3SHARE2K_H_ */
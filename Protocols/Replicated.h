@@ -23,6 +23,8 @@ template<class T> class Share;
 template<class T> class Rep3Share;
 template<class T> class MAC_Check_Base;
 template<class T> class Preprocessing;
+template<class T> class Memory;
+class Instruction;
 
 class ReplicatedBase
 {
@@ -53,6 +55,8 @@ public:
     void muls(const vector<int>& reg, SubProcessor<T>& proc, typename T::MAC_Check& MC,
             int size);
     void mulrs(const vector<int>& reg, SubProcessor<T>& proc);
+    void matmuls(Memory<T>& source, const Instruction& instruction, int a,
+            int b, SubProcessor<T>& proc);
 
     virtual void init_mul(SubProcessor<T>* proc) = 0;
     virtual typename T::clear prepare_mul(const T& x, const T& y, int n = -1) = 0;
@@ -98,6 +102,9 @@ public:
     void init_mul(SubProcessor<T>* proc);
     void init_mul(Preprocessing<T>& prep, typename T::MAC_Check& MC);
 
+    void muls(const vector<int>& reg, SubProcessor<T>& proc,
+            typename T::MAC_Check& MC, int size);
+
     void init_mul();
     typename T::clear prepare_mul(const T& x, const T& y, int n = -1);
     void exchange();
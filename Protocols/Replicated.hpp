@@ -14,6 +14,7 @@
 #include "SemiMC.h"
 #include "ReplicatedInput.h"
 #include "Rep3Share.h"
+#include "ShareColumns.h"
 
 #include "SemiMC.hpp"
 #include "Math/Z2k.hpp"
@@ -85,6 +86,13 @@ void ProtocolBase<T>::mulrs(const vector<int>& reg,
     proc.mulrs(reg);
 }
 
+template<class T>
+void ProtocolBase<T>::matmuls(Memory<T>& source,
+        const Instruction& instruction, int a, int b, SubProcessor<T>& proc)
+{
+    proc.matmuls(source, instruction, a, b);
+}
+
 template<class T>
 T ProtocolBase<T>::finalize_dotprod(int length)
 {
@@ -109,6 +117,51 @@ void Replicated<T>::init_mul(Preprocessing<T>& prep, typename T::MAC_Check& MC)
     init_mul();
 }
 
+template<class T>
+void Replicated<T>::muls(const vector<int>& reg, SubProcessor<T>& proc,
+        typename T::MAC_Check& MC, int size)
+{
+    (void) MC;
+    assert(reg.size() % 3 == 0);
+    int n = reg.size() / 3;
+    size_t total = n * size;
+
+    ShareColumns<T> x(total), y(total);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < size; j++)
+        {
+            x.set(i * size + j, proc.get_S_ref(reg[3 * i + 1] + j));
+            y.set(i * size + j, proc.get_S_ref(reg[3 * i + 2] + j));
+        }
+
+    // same as local_mul() and prepare_reshare() but column by column
+    typedef VectorKernels<typename T::value_type> kernels;
+    typename ShareColumns<T>::column_type add_shares(total), tmp(total);
+    kernels::add(tmp.data(), y[0].data(), y[1].data(), total);
+    kernels::mul(add_shares.data(), x[0].data(), tmp.data(), total);
+    kernels::mul(tmp.data(), x[1].data(), y[0].data(), total);
+    kernels::add(add_shares.data(), add_shares.data(), tmp.data(), total);
+    ShareColumns<T>::randomize(tmp, shared_prngs[0]);
+    kernels::add(add_shares.data(), add_shares.data(), tmp.data(), total);
+    ShareColumns<T>::randomize(tmp, shared_prngs[1]);
+    kernels::sub(add_shares.data(), add_shares.data(), tmp.data(), total);
+
+    init_mul();
+    ShareColumns<T>::pack(add_shares, os[0]);
+    exchange();
+    ShareColumns<T>::unpack(tmp, os[1]);
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < size; j++)
+        {
+            auto& res = proc.get_S_ref(reg[3 * i] + j);
+            res[0] = add_shares[i * size + j];
+            res[1] = tmp[i * size + j];
+        }
+
+    this->counter += total;
+}
+
 template<class T>
 void Replicated<T>::init_mul()
 {
@@ -71,6 +71,9 @@ public:
         assert(T::length == 2);
     }
 
+    void start(int player, int n_inputs);
+    void stop(int player, vector<int> targets);
+
     void reset(int player);
     void add_mine(const typename T::open_type& input, int n_bits = -1);
     void add_other(int player);
@@ -7,6 +7,7 @@
 #define PROTOCOLS_REPLICATEDINPUT_HPP_
 
 #include "ReplicatedInput.h"
+#include "ShareColumns.h"
 #include "Processor/Processor.h"
 
 
@@ -35,6 +36,69 @@ inline void ReplicatedInput<T>::add_mine(const typename T::open_type& input, int
     this->values_input++;
 }
 
+template<class T>
+void ReplicatedInput<T>::start(int player, int n_inputs)
+{
+    typedef typename T::value_type value_type;
+    if (player != P.my_num()
+            or not is_same<typename T::open_type, value_type>::value)
+    {
+        PrepLessInput<T>::start(player, n_inputs);
+        return;
+    }
+
+    // same as add_mine() for all inputs but column by column
+    reset(player);
+    typename ShareColumns<T>::column_type inputs(n_inputs), masks(n_inputs);
+    for (auto& x : inputs)
+    {
+        typename T::clear t;
+        this->buffer.input(t);
+        x = t;
+    }
+    ShareColumns<T>::randomize(masks, protocol.shared_prngs[0]);
+    VectorKernels<value_type>::sub(inputs.data(), inputs.data(),
+            masks.data(), n_inputs);
+    ShareColumns<T>::pack(inputs, os[1]);
+    for (int i = 0; i < n_inputs; i++)
+    {
+        this->shares.push_back({});
+        this->shares.back()[0] = masks[i];
+        this->shares.back()[1] = inputs[i];
+    }
+    this->values_input += n_inputs;
+    send_mine();
+}
+
+template<class T>
+void ReplicatedInput<T>::stop(int player, vector<int> targets)
+{
+    assert(proc != 0);
+    if (player == P.my_num())
+    {
+        PrepLessInput<T>::stop(player, targets);
+        return;
+    }
+
+    // same as finalize_other() for all targets but column by column
+    octetStream o;
+    this->timer.start();
+    P.receive_player(player, o, true);
+    this->timer.stop();
+    typename ShareColumns<T>::column_type column(targets.size());
+    int i_mine = P.get_offset(player) == 1 ? 0 : 1;
+    if (i_mine == 0)
+        ShareColumns<T>::unpack(column, o);
+    else
+        ShareColumns<T>::randomize(column, protocol.shared_prngs[1]);
+    for (size_t i = 0; i < targets.size(); i++)
+    {
+        auto& target = proc->get_S_ref(targets[i]);
+        target[i_mine] = column[i];
+        target[1 - i_mine] = 0;
+    }
+}
+
 template<class T>
 void ReplicatedInput<T>::add_other(int player)
 {
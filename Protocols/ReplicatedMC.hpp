@@ -7,6 +7,7 @@
 #define PROTOCOLS_REPLICATEDMC_HPP_
 
 #include "ReplicatedMC.h"
+#include "ShareColumns.h"
 
 template<class T>
 void ReplicatedMC<T>::POpen(vector<typename T::open_type>& values,
@@ -31,8 +32,10 @@ void ReplicatedMC<T>::prepare(const vector<T>& S)
     assert(T::length == 2);
     o.reset_write_head();
     to_send.reset_write_head();
-    for (auto& x : S)
-        x[0].pack(to_send);
+    typename ShareColumns<T>::column_type column(S.size());
+    for (size_t i = 0; i < S.size(); i++)
+        column[i] = S[i][0];
+    ShareColumns<T>::pack(column, to_send);
 }
 
 template<class T>
@@ -48,12 +51,10 @@ void ReplicatedMC<T>::finalize(vector<typename T::open_type>& values,
         const vector<T>& S)
 {
     values.resize(S.size());
+    typename ShareColumns<T>::column_type received(S.size());
+    ShareColumns<T>::unpack(received, o);
     for (size_t i = 0; i < S.size(); i++)
-    {
-        typename T::open_type tmp;
-        tmp.unpack(o);
-        values[i] = S[i].sum() + tmp;
-    }
+        values[i] = S[i].sum() + received[i];
 }
 
 #endif
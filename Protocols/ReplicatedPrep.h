@@ -43,6 +43,10 @@ protected:
 
     virtual void buffer_dabits() { throw runtime_error("no daBits"); }
 
+    template<class U>
+    void forecast(vector<U>& buffer, long long n_needed,
+            void (BufferPrep<T>::*buffer_more)());
+
 public:
     typedef T share_type;
 
@@ -67,6 +71,8 @@ public:
     T get_random_from_inputs(int nplayers);
 
     virtual void get_dabit(T& a, typename T::bit_type& b);
+
+    void forecast(const DataPositions& usage);
 };
 
 template<class T>
@@ -88,10 +94,17 @@ protected:
     void buffer_squares();
     void buffer_inverses() { throw runtime_error("not inverses in rings"); }
 
+    map<int, vector<pair<T, vector<typename T::bit_type>>>> edabits;
+
     void buffer_bits_without_check();
     void buffer_dabits_without_check(vector<dabit<T>>& dabits,
             int buffer_size = -1);
 
+    // only for three-party replicated secret sharing
+    void buffer_edabits_with_adder(int n_bits);
+    void get_edabit_from_adder(T& a, vector<typename T::bit_type>& bits,
+            int n_bits);
+
 public:
     RingPrep(SubProcessor<T>* proc, DataPositions& usage);
     virtual ~RingPrep() {}
@@ -60,8 +60,7 @@ void ReplicatedRingPrep<T>::buffer_triples()
     assert(this->protocol != 0);
     // independent instance to avoid conflicts
     typename T::Protocol protocol(this->protocol->branch());
-    generate_triples(this->triples, OnlineOptions::singleton.batch_size,
-            &protocol);
+    generate_triples(this->triples, this->buffer_size, &protocol);
 }
 
 template<class T, class U>
@@ -82,6 +81,39 @@ void generate_triples(vector<array<T, 3>>& triples, int n_triples,
         triples[i][2] = protocol->finalize_mul(n_bits);
 }
 
+template<class T>
+void BufferPrep<T>::forecast(const DataPositions& usage)
+{
+    // triples last because the others might be generated from triples
+    auto& files = usage.files[T::field_type()];
+    forecast(bits, files[DATA_BIT], &BufferPrep<T>::buffer_bits);
+    forecast(squares, files[DATA_SQUARE], &BufferPrep<T>::buffer_squares);
+    forecast(triples, files[DATA_TRIPLE], &BufferPrep<T>::buffer_triples);
+}
+
+template<class T>
+template<class U>
+void BufferPrep<T>::forecast(vector<U>& buffer, long long n_needed,
+        void (BufferPrep<T>::*buffer_more)())
+{
+    long long n_missing = n_needed - buffer.size();
+    if (n_missing <= 0)
+        return;
+
+    // one large batch, leftovers are used first
+    vector<U> leftovers;
+    leftovers.swap(buffer);
+    int batch_size = buffer_size;
+    buffer_size = min(n_missing,
+            (long long) OnlineOptions::singleton.forecast_batch_size);
+    int forecast_size = buffer_size;
+    (this->*buffer_more)();
+    // keep the batch size if set by the generator on first use
+    if (buffer_size == forecast_size)
+        buffer_size = batch_size;
+    buffer.insert(buffer.end(), leftovers.begin(), leftovers.end());
+}
+
 template<class T>
 void BufferPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
 {
@@ -104,7 +136,7 @@ template<class T>
 void RingPrep<T>::buffer_squares()
 {
     auto proc = this->proc;
-    auto buffer_size = OnlineOptions::singleton.batch_size;
+    auto buffer_size = this->buffer_size;
     assert(proc != 0);
     vector<T> a_plus_b(buffer_size), as(buffer_size), cs(buffer_size);
     T b;
@@ -126,7 +158,7 @@ void ReplicatedRingPrep<T>::buffer_squares()
     auto proc = this->proc;
     assert(protocol != 0);
     auto& squares = this->squares;
-    squares.resize(OnlineOptions::singleton.batch_size);
+    squares.resize(this->buffer_size);
     protocol->init_mul(proc);
     for (size_t i = 0; i < squares.size(); i++)
     {
@@ -265,8 +297,7 @@ template<class T>
 void RingPrep<T>::buffer_bits_without_check()
 {
     SeededPRNG G;
-    buffer_ring_bits_without_check(this->bits, G,
-            OnlineOptions::singleton.batch_size);
+    buffer_ring_bits_without_check(this->bits, G, this->buffer_size);
 }
 
 template<class T>
@@ -349,6 +380,163 @@ void RingPrep<T>::buffer_dabits_without_check(vector<dabit<T>>& dabits,
     sent += bit_prep.data_sent();
 }
 
+/*
+ * edaBits from the sum of the three components of a random replicated
+ * sharing: every component is known to two parties, so it can be input
+ * to a binary circuit locally. A carry-save adder reduces the three
+ * summands to two, and a ripple-carry adder computes the bits of the
+ * sum. If the bit length is below the ring size, the carries into bit
+ * n_bits are converted to arithmetic with daBits and subtracted.
+ */
+template<class T>
+void RingPrep<T>::buffer_edabits_with_adder(int n_bits)
+{
+    typedef typename T::bit_type::part_type bit_type;
+    typedef typename T::clear clear;
+    const int K = clear::N_BITS;
+    const int block_size = bit_type::clear::n_bits;
+
+    assert(proc != 0);
+    auto& P = proc->P;
+    assert(P.num_players() == 3);
+    assert(n_bits > 0 and n_bits <= K);
+    int n_blocks = DIV_CEIL(OnlineOptions::singleton.batch_size, block_size);
+    int buffer_size = n_blocks * block_size;
+    int my_num = P.my_num();
+
+    Replicated<T> rep(P);
+    vector<T> ints(buffer_size);
+    for (auto& x : ints)
+    {
+        x = rep.get_random();
+        if (n_bits < K)
+            for (int j = 0; j < 2; j++)
+                x[j] = x[j] & ((clear(1) << n_bits) - 1);
+    }
+
+    // bit-sliced binary sharings of the three components,
+    // where party i holds component i and i - 1
+    typedef vector<vector<bit_type>> sliced;
+    array<sliced, 3> inputs;
+    for (int i = 0; i < 3; i++)
+        inputs[i].resize(n_bits, vector<bit_type>(n_blocks));
+    for (int b = 0; b < n_bits; b++)
+        for (int l = 0; l < n_blocks; l++)
+            for (int j = 0; j < 2; j++)
+            {
+                long word = 0;
+                for (int t = 0; t < block_size; t++)
+                    word |= long(ints[l * block_size + t][j].get_bit(b)) << t;
+                inputs[(my_num - j + 3) % 3][b][l][j] = word;
+            }
+
+    auto& party = GC::ShareThread<typename T::bit_type>::s();
+    auto& MC = *bit_type::new_mc(party.MC->get_alphai());
+    DataPositions usage(P.num_players());
+    typename bit_type::LivePrep bit_prep(usage);
+    SubProcessor<bit_type> bit_proc(MC, bit_prep, P);
+    auto& protocol = bit_proc.protocol;
+
+    // carry-save adder
+    sliced sums(n_bits, vector<bit_type>(n_blocks));
+    sliced carries = sums;
+    protocol.init_mul(&bit_proc);
+    for (int b = 0; b < n_bits; b++)
+        for (int l = 0; l < n_blocks; l++)
+        {
+            auto& x = inputs[0][b][l];
+            auto& y = inputs[1][b][l];
+            auto& z = inputs[2][b][l];
+            sums[b][l] = x ^ y ^ z;
+            protocol.prepare_mul(x ^ y, x ^ z, block_size);
+        }
+    protocol.exchange();
+    for (int b = 0; b < n_bits; b++)
+        for (int l = 0; l < n_blocks; l++)
+            carries[b][l] = inputs[0][b][l]
+                    ^ protocol.finalize_mul(block_size);
+
+    // ripple-carry adder for sums + 2 * carries
+    sliced bits(n_bits, vector<bit_type>(n_blocks));
+    vector<bit_type> carry(n_blocks);
+    bits[0] = sums[0];
+    for (int b = 1; b < n_bits; b++)
+    {
+        for (int l = 0; l < n_blocks; l++)
+            bits[b][l] = sums[b][l] ^ carries[b - 1][l] ^ carry[l];
+        if (b == n_bits - 1 and n_bits == K)
+            break;
+        protocol.init_mul(&bit_proc);
+        for (int l = 0; l < n_blocks; l++)
+            protocol.prepare_mul(sums[b][l] ^ carry[l],
+                    carries[b - 1][l] ^ carry[l], block_size);
+        protocol.exchange();
+        for (int l = 0; l < n_blocks; l++)
+            carry[l] = carry[l] ^ protocol.finalize_mul(block_size);
+    }
+
+    if (n_bits < K)
+    {
+        // remove the two carries into bit n_bits
+        vector<T> masks;
+        vector<bit_type> masked;
+        for (auto& overflow : {carry, carries[n_bits - 1]})
+            for (int l = 0; l < n_blocks; l++)
+            {
+                bit_type mask;
+                for (int t = 0; t < block_size; t++)
+                {
+                    typename T::bit_type b;
+                    masks.push_back({});
+                    this->get_dabit(masks.back(), b);
+                    mask = mask ^ (b << t);
+                }
+                masked.push_back(overflow[l] ^ mask);
+            }
+        vector<typename bit_type::open_type> opened;
+        MC.POpen(opened, masked, P);
+        T one = T::constant(1, my_num);
+        for (int i = 0; i < 2; i++)
+            for (int l = 0; l < n_blocks; l++)
+                for (int t = 0; t < block_size; t++)
+                {
+                    auto& mask = masks[(i * n_blocks + l) * block_size + t];
+                    if (opened[i * n_blocks + l].get_bit(t))
+                        mask = one - mask;
+                    auto& x = ints[l * block_size + t];
+                    x = x - (mask << n_bits);
+                }
+    }
+
+    MC.Check(P);
+    delete &MC;
+    sent += bit_prep.data_sent();
+
+    auto& buffer = edabits[n_bits];
+    for (int l = 0; l < n_blocks; l++)
+        for (int t = 0; t < block_size; t++)
+        {
+            buffer.push_back({ints[l * block_size + t], {}});
+            auto& res = buffer.back().second;
+            res.resize(n_bits);
+            for (int b = 0; b < n_bits; b++)
+                for (int j = 0; j < 2; j++)
+                    res[b][j] = bits[b][l][j].get_bit(t);
+        }
+}
+
+template<class T>
+void RingPrep<T>::get_edabit_from_adder(T& a,
+        vector<typename T::bit_type>& bits, int n_bits)
+{
+    auto& buffer = edabits[n_bits];
+    if (buffer.empty())
+        buffer_edabits_with_adder(n_bits);
+    a = buffer.back().first;
+    bits = buffer.back().second;
+    buffer.pop_back();
+}
+
 template<>
 inline
 void SemiHonestRingPrep<Rep3Share<gf2n>>::buffer_bits()
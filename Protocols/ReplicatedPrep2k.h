@@ -22,6 +22,13 @@ public:
         this->get_one(DATA_BIT, a);
         b = a & 1;
     }
+
+    bool get_edabit_no_count(T& a, vector<typename T::bit_type>& bits,
+            int n_bits)
+    {
+        this->get_edabit_from_adder(a, bits, n_bits);
+        return true;
+    }
 };
 
 #endif /* PROTOCOLS_REPLICATEDPREP2K_H_ */
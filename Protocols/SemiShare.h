@@ -9,6 +9,7 @@
 #include "Protocols/Beaver.h"
 #include "Processor/DummyProtocol.h"
 #include "Processor/NoLivePrep.h"
+#include "Math/VectorKernels.h"
 
 #include <string>
 using namespace std;
@@ -138,4 +139,9 @@ public:
     }
 };
 
+template<class T>
+struct gf2n_words<SemiShare<T>> : gf2n_words<T>
+{
+};
+
 #endif /* PROTOCOLS_SEMISHARE_H_ */
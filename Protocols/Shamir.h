@@ -26,12 +26,15 @@ class Shamir : public ProtocolBase<ShamirShare<U>>
     vector<octetStream> os;
     vector<U> reconstruction;
     U rec_factor;
+    U dotprod_share;
     ShamirInput<T>* resharing;
 
     SeededPRNG secure_prng;
 
     vector<T> random;
 
+    vector<vector<U>> extraction;
+
     void buffer_random();
 
     int threshold;
@@ -43,6 +46,7 @@ public:
     Player& P;
 
     static U get_rec_factor(int i, int n);
+    static vector<vector<U>> get_extraction_matrix(int n, int t);
 
     Shamir(Player& P);
     ~Shamir();
@@ -58,6 +62,7 @@ public:
     U prepare_mul(const T& x, const T& y, int n = -1);
 
     void exchange();
+    void exchange(int n_senders);
     void start_exchange();
     void stop_exchange();
 
@@ -65,6 +70,11 @@ public:
 
     T finalize(int n_input_players);
 
+    void init_dotprod(SubProcessor<T>* proc);
+    void prepare_dotprod(const T& x, const T& y);
+    void next_dotprod();
+    T finalize_dotprod(int length);
+
     T get_random();
 };
 
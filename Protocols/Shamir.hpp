@@ -8,6 +8,7 @@
 #include "Machines/ShamirMachine.h"
 #include "Tools/benchmarking.h"
 
+
 template<class U>
 U Shamir<U>::get_rec_factor(int i, int n)
 {
@@ -18,6 +19,25 @@ U Shamir<U>::get_rec_factor(int i, int n)
     return res;
 }
 
+// (n - t) x n Vandermonde matrix, any n - t columns of which are invertible,
+// so that applying it to sharings dealt by all parties results in n - t
+// random sharings unknown to any t parties
+template<class U>
+vector<vector<U>> Shamir<U>::get_extraction_matrix(int n, int t)
+{
+    vector<vector<U>> extraction(n - t, vector<U>(n));
+    for (int i = 0; i < n; i++)
+    {
+        U x = 1;
+        for (int j = 0; j < n - t; j++)
+        {
+            extraction[j][i] = x;
+            x *= U(i + 1);
+        }
+    }
+    return extraction;
+}
+
 template<class U>
 Shamir<U>::Shamir(Player& P) : resharing(0), P(P)
 {
@@ -89,21 +109,17 @@ U Shamir<U>::prepare_mul(const T& x, const T& y, int n)
 template<class U>
 void Shamir<U>::exchange()
 {
-    for (int offset = 1; offset < P.num_players(); offset++)
-    {
-        int receive_from = P.get_player(-offset);
-        int send_to = P.get_player(offset);
-        bool receive = receive_from < n_mul_players;
-        if (P.my_num() < n_mul_players)
-        {
-            if (receive)
-                P.pass_around(resharing->os[send_to], os[receive_from], offset);
-            else
-                P.send_to(send_to, resharing->os[send_to], true);
-        }
-        else if (receive)
-            P.receive_player(receive_from, os[receive_from], true);
-    }
+    exchange(n_mul_players);
+}
+
+template<class U>
+void Shamir<U>::exchange(int n_senders)
+{
+    int n = P.num_players();
+    vector<vector<bool>> channels(n, vector<bool>(n));
+    for (int i = 0; i < n_senders; i++)
+        channels[i].assign(n, true);
+    P.send_receive_all(channels, resharing->os, os);
 }
 
 template<class U>
@@ -148,6 +164,35 @@ ShamirShare<U> Shamir<U>::finalize(int n_relevant_players)
     return res;
 }
 
+template<class U>
+void Shamir<U>::init_dotprod(SubProcessor<T>* proc)
+{
+    init_mul(proc);
+    dotprod_share = 0;
+}
+
+template<class U>
+void Shamir<U>::prepare_dotprod(const T& x, const T& y)
+{
+    dotprod_share += x * y;
+}
+
+template<class U>
+void Shamir<U>::next_dotprod()
+{
+    if (P.my_num() < n_mul_players)
+        resharing->add_mine(dotprod_share * rec_factor);
+    dotprod_share = 0;
+}
+
+template<class U>
+ShamirShare<U> Shamir<U>::finalize_dotprod(int length)
+{
+    (void) length;
+    this->counter++;
+    return finalize_mul();
+}
+
 template<class U>
 ShamirShare<U> Shamir<U>::get_random()
 {
@@ -161,13 +206,32 @@ ShamirShare<U> Shamir<U>::get_random()
 template<class U>
 void Shamir<U>::buffer_random()
 {
+    // every party deals, and extraction turns n sharings into n - t
+    int n = P.num_players();
+    int n_out = n - threshold;
+    if (extraction.empty())
+        extraction = get_extraction_matrix(n, threshold);
+    auto& matrix = extraction;
     Shamir<U> shamir(P);
     shamir.reset();
-    int buffer_size = OnlineOptions::singleton.batch_size;
-    if (P.my_num() <= threshold)
-        for (int i = 0; i < buffer_size; i++)
-            shamir.resharing->add_mine(secure_prng.get<U>());
-    shamir.exchange();
+    int buffer_size = DIV_CEIL(OnlineOptions::singleton.batch_size, n_out);
+    for (int i = 0; i < buffer_size; i++)
+        shamir.resharing->add_mine(secure_prng.get<U>());
+    shamir.exchange(n);
+    vector<T> dealt(n);
     for (int i = 0; i < buffer_size; i++)
-        random.push_back(shamir.finalize(threshold + 1));
+    {
+        for (int j = 0; j < n; j++)
+            if (j == P.my_num())
+                dealt[j] = shamir.resharing->finalize_mine();
+            else
+                shamir.resharing->finalize_other(j, dealt[j], shamir.os[j]);
+        for (int k = 0; k < n_out; k++)
+        {
+            T res = U(0);
+            for (int j = 0; j < n; j++)
+                res += dealt[j] * matrix[k][j];
+            random.push_back(res);
+        }
+    }
 }
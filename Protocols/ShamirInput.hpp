@@ -9,9 +9,6 @@
 #include "ShamirInput.h"
 #include "Machines/ShamirMachine.h"
 
-template<class T>
-vector<vector<typename T::clear>> ShamirInput<T>::vandermonde;
-
 template<class U>
 void IndividualInput<U>::reset(int player)
 {
@@ -25,23 +22,21 @@ void IndividualInput<U>::reset(int player)
 }
 
 template<class T>
-const vector<vector<typename T::clear>>& ShamirInput<T>::get_vandermonde(
+vector<vector<typename T::clear>> ShamirInput<T>::get_vandermonde(
         size_t t, size_t n)
 {
-    if (vandermonde.size() < n)
-        vandermonde.resize(n);
+    vector<vector<typename T::clear>> vandermonde(n);
 
     for (int i = 0; i < int(n); i++)
-        if (vandermonde[i].size() < t)
+    {
+        vandermonde[i].resize(t);
+        typename T::clear x = 1;
+        for (size_t j = 0; j < t; j++)
         {
-            vandermonde[i].resize(t);
-            typename T::clear x = 1;
-            for (size_t j = 0; j < t; j++)
-            {
-                x *= (i + 1);
-                vandermonde[i][j] = x;
-            }
+            x *= (i + 1);
+            vandermonde[i][j] = x;
         }
+    }
 
     return vandermonde;
 }
@@ -53,7 +48,9 @@ void ShamirInput<T>::add_mine(const typename T::clear& input, int n_bits)
     auto& P = this->P;
     int n = P.num_players();
     int t = ShamirMachine::s().threshold;
-    const auto& vandermonde = get_vandermonde(t, n);
+    // per instance to avoid sharing between threads
+    if (vandermonde.empty())
+        vandermonde = get_vandermonde(t, n);
 
     randomness.resize(t);
     for (auto& x : randomness)
@@ -39,19 +39,10 @@ void ShamirMC<T>::POpen(vector<typename T::clear>& values, const vector<T>& S,
 template<class T>
 void ShamirMC<T>::exchange(const Player& P)
 {
-    for (int offset = 1; offset < P.num_players(); offset++)
-    {
-        int send_to = P.get_player(offset);
-        int receive_from = P.get_player(-offset);
-        bool receive = receive_from <= threshold;
-        if (send)
-            if (receive)
-                P.pass_around(os[P.my_num()], os[receive_from], offset);
-            else
-                P.send_to(send_to, os[P.my_num()], true);
-        else if (receive)
-            P.receive_player(receive_from, os[receive_from], true);
-    }
+    vector<bool> senders(P.num_players());
+    for (int i = 0; i <= threshold; i++)
+        senders[i] = true;
+    P.partial_broadcast(senders, os);
 }
 
 template<class T>
@@ -251,4 +251,10 @@ inline void Share_<T, V>::assign(const clear& aa, int my_num,
 #endif
 }
 
+template<class T>
+struct gf2n_words<Share<T>>
+{
+    static const int value = 2 * gf2n_words<T>::value;
+};
+
 #endif
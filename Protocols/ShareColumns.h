@@ -0,0 +1,126 @@
+/*
+ * ShareColumns.h
+ *
+ */
+
+#ifndef PROTOCOLS_SHARECOLUMNS_H_
+#define PROTOCOLS_SHARECOLUMNS_H_
+
+#include "Math/VectorKernels.h"
+#include "Tools/octetStream.h"
+#include "Tools/random.h"
+
+#include <array>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+/*
+ * Replicated shares stored as one contiguous vector per component
+ * (structure of arrays) instead of interleaved. Batched operations
+ * convert to this layout from the register file and back, so that
+ * the local computation, randomness, and communication work on
+ * contiguous memory.
+ */
+template<class T>
+class ShareColumns
+{
+public:
+    typedef typename T::value_type value_type;
+    typedef vector<value_type> column_type;
+
+private:
+    array<column_type, T::length> columns;
+
+    // packing is a plain copy of the memory representation
+    static bool flat()
+    {
+        return ring_words<value_type>::value == 1
+                and value_type::size() == sizeof(value_type);
+    }
+
+    static void normalize(column_type& x, true_type)
+    {
+        for (auto& y : x)
+            y.normalize();
+    }
+    static void normalize(column_type&, false_type)
+    {
+    }
+
+public:
+    ShareColumns(size_t n = 0)
+    {
+        resize(n);
+    }
+
+    void resize(size_t n)
+    {
+        for (auto& column : columns)
+            column.resize(n);
+    }
+
+    size_t size() const
+    {
+        return columns[0].size();
+    }
+
+    column_type& operator[](int i)
+    {
+        return columns[i];
+    }
+
+    const column_type& operator[](int i) const
+    {
+        return columns[i];
+    }
+
+    void set(size_t i, const T& x)
+    {
+        for (int j = 0; j < T::length; j++)
+            columns[j][i] = x[j];
+    }
+
+    T get(size_t i) const
+    {
+        T res;
+        for (int j = 0; j < T::length; j++)
+            res[j] = columns[j][i];
+        return res;
+    }
+
+    // same output as calling randomize() on every element in order
+    static void randomize(column_type& x, PRNG& G)
+    {
+        if (flat())
+        {
+            G.get_octets((octet*) x.data(), x.size() * sizeof(value_type));
+            normalize(x, integral_constant<bool,
+                    ring_words<value_type>::value == 1>());
+        }
+        else
+            for (auto& y : x)
+                y.randomize(G);
+    }
+
+    // same output as calling pack() on every element in order
+    static void pack(const column_type& x, octetStream& os)
+    {
+        if (flat())
+            os.append((octet*) x.data(), x.size() * sizeof(value_type));
+        else
+            for (auto& y : x)
+                y.pack(os);
+    }
+
+    static void unpack(column_type& x, octetStream& os)
+    {
+        if (flat())
+            os.consume((octet*) x.data(), x.size() * sizeof(value_type));
+        else
+            for (auto& y : x)
+                y.unpack(os);
+    }
+};
+
+#endif /* PROTOCOLS_SHARECOLUMNS_H_ */
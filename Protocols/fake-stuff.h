@@ -6,6 +6,7 @@
 using namespace std;
 
 #include "Networking/Player.h"
+#include "Tools/Buffer.h"
 
 template<class T>
 void check_share(vector<T>& Sa, typename T::clear& value,
@@ -39,7 +40,8 @@ public:
   int N;
   typename T::mac_key_type key;
   PRNG G;
-  Files(int N, const typename T::mac_key_type& key, const string& prefix) : N(N), key(key)
+  Files(int N, const typename T::mac_key_type& key, const string& prefix,
+      int tuple_size = 1) : N(N), key(key)
   {
     outf = new ofstream[N];
     for (int i=0; i<N; i++)
@@ -50,6 +52,7 @@ public:
         outf[i].open(filename.str().c_str(),ios::out | ios::binary);
         if (outf[i].fail())
           throw file_error(filename.str().c_str());
+        write_prep_header<T>(outf[i], tuple_size * T::size());
       }
     G.ReSeed();
   }
@@ -120,7 +120,7 @@ template<class T>
 void make_share(ShamirShare<T>* Sa, const T& a, int N, const T&, PRNG& G)
 {
   insecure("share generation", false);
-  const auto& vandermonde = ShamirInput<ShamirShare<T>>::get_vandermonde(N / 2, N);
+  auto vandermonde = ShamirInput<ShamirShare<T>>::get_vandermonde(N / 2, N);
   vector<T> randomness(N / 2);
   for (auto& x : randomness)
       x.randomize(G);
@@ -335,6 +335,7 @@ void make_mult_triples(const typename T::mac_key_type& key, int N, int ntrip,
       cout << "Opening " << filename.str() << endl;
       outf[i].open(filename.str().c_str(),ios::out | ios::binary);
       if (outf[i].fail()) { throw file_error(filename.str().c_str()); }
+      write_prep_header<T>(outf[i], 3 * T::size());
     }
   for (int i=0; i<ntrip; i++)
     {
@@ -378,6 +379,7 @@ void make_inverse(const typename T::mac_key_type& key, int N, int ntrip, bool ze
       cout << "Opening " << filename.str() << endl;
       outf[i].open(filename.str().c_str(),ios::out | ios::binary);
       if (outf[i].fail()) { throw file_error(filename.str().c_str()); }
+      write_prep_header<T>(outf[i], 2 * T::size());
     }
   for (int i=0; i<ntrip; i++)
     {
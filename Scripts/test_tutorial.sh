@@ -47,7 +47,7 @@ for dabit in ${dabit:-0 1}; do
     done
 
     if [[ ! "$dabit" = 1 ]]; then
-	for i in shamir mal-shamir; do
+	for i in shamir mal-shamir king-shamir; do
 	    test_vm $i
 	done
     fi
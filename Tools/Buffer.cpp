@@ -6,6 +6,10 @@
 #include "Tools/Buffer.h"
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <map>
 
 bool BufferBase::rewind = false;
 
@@ -18,11 +22,245 @@ void BufferBase::setup(ifstream* f, int length, string filename,
     data_type = type;
     field_type = field;
     this->filename = filename;
+    pipe = f and is_pipe(filename);
 }
 
-void BufferBase::seekg(int pos)
+map<string, string> parse_prep_header(const string& header)
 {
-    file->seekg(pos * tuple_length);
+    map<string, string> res;
+    stringstream ss(header);
+    string key, value;
+    while (ss >> key and getline(ss >> ws, value))
+        res[key] = value;
+    return res;
+}
+
+void BufferBase::check_header(const string& found)
+{
+    auto expected_fields = parse_prep_header(signature);
+    auto found_fields = parse_prep_header(found);
+
+    if (found_fields["version"] != "1")
+        throw runtime_error("unknown version of preprocessing file " + filename);
+    for (auto& field : expected_fields)
+    {
+        if (field.first == "tuple_length" and tuple_length <= 0)
+            continue;
+        if (found_fields[field.first] != field.second)
+            throw runtime_error(
+                    "preprocessing file " + filename + " has " + field.first
+                            + " " + found_fields[field.first] + " instead of "
+                            + field.second);
+    }
+}
+
+void BufferBase::read_header_body(istream& s)
+{
+    uint64_t length = 0;
+    s.read((char*) &length, sizeof(length));
+    string found(s.good() and length < (1 << 20) ? length : 0, 0);
+    s.read(&found[0], found.size());
+    if (s.fail() or found.size() != length)
+        throw runtime_error("invalid header in " + filename);
+    check_header(found);
+    header = string(prep_file_magic, prep_file_magic_length);
+    header.append((char*) &length, sizeof(length));
+    header += found;
+}
+
+void BufferBase::read_file_header()
+{
+    header.clear();
+    header_length = 0;
+    if (not file or not file->good())
+        return;
+    char magic[prep_file_magic_length];
+    file->read(magic, prep_file_magic_length);
+    if (file->gcount() == prep_file_magic_length
+            and memcmp(magic, prep_file_magic, prep_file_magic_length) == 0)
+    {
+        read_header_body(*file);
+        header_length = header.size();
+    }
+    else
+    {
+        // legacy file without header
+        file->clear();
+        file->seekg(0);
+    }
+}
+
+void BufferBase::skip_file_header(ifstream& file, string filename)
+{
+    // for tools reading the content themselves
+    BufferBase buffer;
+    buffer.setup(&file, 0, filename);
+    buffer.read_file_header();
+}
+
+void BufferBase::read_pipe_header()
+{
+    if (signature.empty())
+        return;
+    // every producer starts with a header unless it writes legacy data
+    char magic[prep_file_magic_length];
+    file->read(magic, prep_file_magic_length);
+    if (file->gcount() == prep_file_magic_length
+            and memcmp(magic, prep_file_magic, prep_file_magic_length) == 0)
+        read_header_body(*file);
+    else
+        pending.append(magic, file->gcount());
+}
+
+size_t BufferBase::take_pending(char* buffer, size_t n)
+{
+    n = min(n, pending.size());
+    if (buffer)
+        memcpy(buffer, pending.data(), n);
+    pending.erase(0, n);
+    return n;
+}
+
+bool BufferBase::is_pipe(string filename)
+{
+    struct stat st;
+    return stat(filename.c_str(), &st) == 0 and S_ISFIFO(st.st_mode);
+}
+
+void BufferBase::open_pipe()
+{
+    if (not file->is_open())
+    {
+        file->open(filename, ios::in | ios::binary);
+        if (file->fail())
+            throw file_error(filename);
+        read_pipe_header();
+    }
+    // seeking on a pipe means discarding
+    char buffer[4096];
+    while (to_skip > 0)
+    {
+        size_t n = take_pending(0, to_skip);
+        to_skip -= n;
+        position += n;
+        if (file->eof())
+            reopen_pipe();
+        file->read(buffer, min(to_skip, sizeof(buffer)));
+        to_skip -= file->gcount();
+        position += file->gcount();
+        if (file->fail() and not file->eof())
+            throw file_error(filename);
+    }
+}
+
+void BufferBase::reopen_pipe()
+{
+    // the producer closed its end, wait for it to open again
+    file->close();
+    file->clear();
+    file->open(filename, ios::in | ios::binary);
+    if (file->fail())
+        throw file_error(filename);
+    size_t n_pending = pending.size();
+    read_pipe_header();
+    // a producer without data means that no more is coming
+    if (pending.size() == n_pending
+            and file->peek() == ifstream::traits_type::eof())
+        throw_not_enough();
+}
+
+void BufferBase::pipe_seekg(long long pos, size_t buffered,
+        size_t element_size)
+{
+    size_t target = pos * tuple_length;
+    size_t current = position + to_skip - buffered;
+    if (target < current)
+        throw runtime_error("cannot seek backwards in pipe " + filename);
+    size_t ahead = target - current;
+    if (ahead <= buffered)
+        next += ahead / element_size;
+    else
+    {
+        // skip when reading next, nothing to read for the time being
+        to_skip += ahead - buffered;
+        next = n_buffered;
+    }
+}
+
+bool BufferBase::setup_mapping(string filename, int length, const char* type,
+        const char* field)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) < 0 or st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    void* res = mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (res == MAP_FAILED)
+        return false;
+
+    madvise(res, st.st_size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    madvise(res, st.st_size, MADV_HUGEPAGE);
+#endif
+
+    setup(0, length, filename, type, field);
+    mapping = (const char*) res;
+    mapping_size = st.st_size;
+    header.clear();
+    header_length = 0;
+    uint64_t header_size;
+    size_t prefix = prep_file_magic_length + sizeof(header_size);
+    if (mapping_size >= prefix
+            and memcmp(mapping, prep_file_magic, prep_file_magic_length) == 0)
+    {
+        memcpy(&header_size, mapping + prep_file_magic_length,
+                sizeof(header_size));
+        if (header_size > mapping_size - prefix)
+            throw runtime_error("invalid header in " + filename);
+        header_length = prefix + header_size;
+        check_header(string(mapping + prefix, header_size));
+        header = string(mapping, header_length);
+    }
+    position = header_length;
+    return true;
+}
+
+void BufferBase::unmap()
+{
+    if (mapping)
+        munmap((void*) mapping, mapping_size);
+    mapping = 0;
+    mapping_size = 0;
+    position = 0;
+    header_length = 0;
+}
+
+const char* BufferBase::next_mapped(size_t n_bytes)
+{
+    if (position + n_bytes > mapping_size)
+        try_rewind();
+    const char* res = mapping + position;
+    position += n_bytes;
+    return res;
+}
+
+void BufferBase::seekg(long long pos)
+{
+    if (mapping)
+    {
+        position = header_length + pos * tuple_length;
+        if (position > mapping_size and pos != 0)
+            try_rewind();
+        return;
+    }
+
+    file->seekg(header_length + pos * tuple_length);
     if (file->eof() || file->fail())
     {
         // let it go in case we don't need it anyway
@@ -32,18 +270,32 @@ void BufferBase::seekg(int pos)
     next = BUFFER_SIZE;
 }
 
-void BufferBase::try_rewind()
+void BufferBase::throw_not_enough()
 {
-#ifndef INSECURE
     string type;
     if (field_type.size() and data_type.size())
         type = (string)" of " + field_type + " " + data_type;
     throw not_enough_to_buffer(type);
+}
+
+void BufferBase::try_rewind()
+{
+#ifndef INSECURE
+    throw_not_enough();
 #endif
-    file->clear(); // unset EOF flag
-    file->seekg(0);
-    if (file->peek() == ifstream::traits_type::eof())
-        throw runtime_error("empty file: " + filename);
+    if (mapping)
+    {
+        if (mapping_size < header_length + tuple_length)
+            throw runtime_error("empty file: " + filename);
+        position = header_length;
+    }
+    else
+    {
+        file->clear(); // unset EOF flag
+        file->seekg(header_length);
+        if (file->peek() == ifstream::traits_type::eof())
+            throw runtime_error("empty file: " + filename);
+    }
     if (!rewind)
         cerr << "REWINDING - ONLY FOR BENCHMARKING" << endl;
     rewind = true;
@@ -52,22 +304,47 @@ void BufferBase::try_rewind()
 
 void BufferBase::prune()
 {
-    if (file and file->tellg() != 0)
+    if (pipe)
+        return;
+    if (mapping and position != header_length)
     {
         cerr << "Pruning " << filename << endl;
         string tmp_name = filename + ".new";
         ofstream tmp(tmp_name.c_str());
+        tmp << header;
+        tmp.write(mapping + position, mapping_size - min(position, mapping_size));
+        tmp.close();
+        unmap();
+        rename(tmp_name.c_str(), filename.c_str());
+        setup_mapping(filename, tuple_length, data_type.c_str(),
+                field_type.c_str());
+    }
+    else if (file and file->tellg() != (streampos) header_length)
+    {
+        cerr << "Pruning " << filename << endl;
+        string tmp_name = filename + ".new";
+        ofstream tmp(tmp_name.c_str());
+        tmp << header;
         tmp << file->rdbuf();
         tmp.close();
         file->close();
         rename(tmp_name.c_str(), filename.c_str());
         file->open(filename.c_str(), ios::in | ios::binary);
+        read_file_header();
     }
 }
 
 void BufferBase::purge()
 {
-    if (file)
+    if (pipe)
+        return;
+    if (mapping)
+    {
+        cerr << "Removing " << filename << endl;
+        unlink(filename.c_str());
+        unmap();
+    }
+    else if (file)
     {
         cerr << "Removing " << filename << endl;
         unlink(filename.c_str());
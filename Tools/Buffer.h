@@ -8,6 +8,9 @@
 
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string.h>
+#include <stdint.h>
 using namespace std;
 
 #include "Math/field_types.h"
@@ -17,29 +20,115 @@ using namespace std;
 #define BUFFER_SIZE 101
 #endif
 
+/*
+ * Preprocessing files may start with this magic, the length of a textual
+ * header as 64-bit little-endian integer, and the header itself.
+ * The header consists of "key value" lines describing the content.
+ * Files without it are read as before.
+ */
+const char prep_file_magic[] = "SPDZPREP";
+const int prep_file_magic_length = 8;
+
+template<class T>
+auto prep_field_description(int) -> decltype(T::clear::pr(), string())
+{
+    stringstream ss;
+    ss << "modulus " << T::clear::pr() << endl;
+    return ss.str();
+}
+
+template<class T>
+auto prep_field_description(long) -> decltype(T::clear::degree(), string())
+{
+    stringstream ss;
+    ss << "degree " << T::clear::degree() << endl;
+    return ss.str();
+}
+
+template<class T>
+string prep_field_description(...)
+{
+    return "";
+}
+
+template<class T>
+string prep_file_header(int tuple_length)
+{
+    stringstream ss;
+    ss << "version 1" << endl;
+    ss << "type " << T::type_string() << endl;
+    ss << "tuple_length " << tuple_length << endl;
+    ss << prep_field_description<T>(0);
+    return ss.str();
+}
+
+template<class T>
+void write_prep_header(ostream& out, int tuple_length)
+{
+    string header = prep_file_header<T>(tuple_length);
+    uint64_t length = header.size();
+    out.write(prep_file_magic, prep_file_magic_length);
+    out.write((char*) &length, sizeof(length));
+    out << header;
+}
+
 class BufferBase
 {
 protected:
     static bool rewind;
 
     ifstream* file;
+    const char* mapping;
+    size_t mapping_size;
+    size_t position;
     int next;
+    // a pipe may deliver fewer than BUFFER_SIZE elements
+    int n_buffered;
     string data_type;
     string field_type;
     Timer timer;
     int tuple_length;
     string filename;
 
+    // expected header and the one found, empty for legacy files
+    string signature;
+    string header;
+    size_t header_length;
+
+    // named pipe fed by a concurrent producer, position counts bytes read
+    bool pipe;
+    size_t to_skip;
+    // bytes read while looking for a header that turned out to be data
+    string pending;
+
+    void check_header(const string& found);
+    void read_header_body(istream& s);
+    void read_pipe_header();
+    size_t take_pending(char* buffer, size_t n);
+    void open_pipe();
+    void reopen_pipe();
+    void throw_not_enough();
+    void pipe_seekg(long long pos, size_t buffered, size_t element_size);
+
 public:
     bool eof;
 
-    BufferBase() : file(0), next(BUFFER_SIZE),
-            tuple_length(-1), eof(false) {}
+    static bool is_pipe(string filename);
+    static void skip_file_header(ifstream& file, string filename);
+
+    BufferBase() : file(0), mapping(0), mapping_size(0), position(0),
+            next(BUFFER_SIZE), n_buffered(BUFFER_SIZE), tuple_length(-1),
+            header_length(0), pipe(false), to_skip(0), eof(false) {}
     void setup(ifstream* f, int length, string filename, const char* type = "",
             const char* field = "");
-    void seekg(int pos);
-    bool is_up() { return file != 0; }
+    bool setup_mapping(string filename, int length, const char* type = "",
+            const char* field = "");
+    void read_file_header();
+    void unmap();
+    void seekg(long long pos);
+    bool is_up() { return file != 0 or mapping != 0; }
     void try_rewind();
+    const char* next_mapped(size_t n_bytes);
     void prune();
     void purge();
 };
@@ -50,12 +139,14 @@ class Buffer : public BufferBase
 {
     T buffer[BUFFER_SIZE];
 
-    void read(char* read_buffer);
+    int read(char* read_buffer);
+    void input_mapped(U& a);
 
 public:
     ~Buffer();
     void input(U& a);
     void fill_buffer();
+    void seekg(long long pos);
 };
 
 template<class U, class V>
@@ -69,10 +160,23 @@ public:
     {
     }
 
-    void setup(string filename, int tuple_length, const char* data_type = "")
+    void setup(string filename, int tuple_length, const char* data_type = "",
+            bool use_mapping = false)
     {
-        file = new ifstream(filename, ios::in | ios::binary);
+        this->signature = prep_file_header<U>(tuple_length);
+        // opening a pipe blocks until there is a writer, so defer it
+        bool pipe = this->is_pipe(filename);
+        if (use_mapping and not pipe
+                and this->setup_mapping(filename, tuple_length, data_type,
+                        U::type_string().c_str()))
+            return;
+        if (pipe)
+            file = new ifstream;
+        else
+            file = new ifstream(filename, ios::in | ios::binary);
         Buffer<U, V>::setup(file, tuple_length, filename, data_type, U::type_string().c_str());
+        if (not pipe)
+            this->read_file_header();
     }
 
     void close()
@@ -80,6 +184,7 @@ public:
         if (file)
             delete file;
         file = 0;
+        this->unmap();
     }
 };
 
@@ -97,35 +202,48 @@ inline void Buffer<T, U>::fill_buffer()
   if (T::size() == sizeof(T))
     {
       // read directly
-      read((char*)buffer);
+      n_buffered = read((char*)buffer);
     }
   else
     {
       char read_buffer[BUFFER_SIZE * T::size()];
-      read(read_buffer);
+      n_buffered = read(read_buffer);
       //memset(buffer, 0, sizeof(buffer));
-      for (int i = 0; i < BUFFER_SIZE; i++)
+      for (int i = 0; i < n_buffered; i++)
         buffer[i].assign(&read_buffer[i*T::size()]);
     }
 }
 
 template<class T, class U>
-inline void Buffer<T, U>::read(char* read_buffer)
+inline int Buffer<T, U>::read(char* read_buffer)
 {
     int size_in_bytes = T::size() * BUFFER_SIZE;
     int n_read = 0;
     timer.start();
     if (not file)
         throw IO_Error(T::type_string() + " buffer not set up");
+    if (pipe)
+        open_pipe();
     do
     {
+        if (pipe)
+        {
+            n_read += take_pending(read_buffer + n_read, size_in_bytes - n_read);
+            if (file->eof())
+            {
+                // hand out what there is and only wait for another
+                // producer when more is needed
+                if (n_read >= T::size())
+                    break;
+                reopen_pipe();
+                continue;
+            }
+        }
         file->read(read_buffer + n_read, size_in_bytes - n_read);
         n_read += file->gcount();
-        if (file->eof())
-        {
+        if (file->eof() and not pipe)
             try_rewind();
-        }
-        if (file->fail())
+        if (file->fail() and not (pipe and file->eof()))
           {
             stringstream ss;
             ss << "IO problem when buffering " << T::type_string();
@@ -136,13 +254,37 @@ inline void Buffer<T, U>::read(char* read_buffer)
           }
     }
     while (n_read < size_in_bytes);
+    if (pipe)
+    {
+        // keep an incomplete element for later
+        int rest = n_read % T::size();
+        n_read -= rest;
+        pending.insert(0, read_buffer + n_read, rest);
+        position += n_read;
+    }
     timer.stop();
+    return n_read / T::size();
+}
+
+template<class T, class U>
+inline void Buffer<T, U>::seekg(long long pos)
+{
+    if (pipe)
+        pipe_seekg(pos, (n_buffered - next) * T::size(), T::size());
+    else
+        BufferBase::seekg(pos);
 }
 
 template <class T, class U>
 inline void Buffer<T,U>::input(U& a)
 {
-    if (next == BUFFER_SIZE)
+    if (mapping)
+    {
+        input_mapped(a);
+        return;
+    }
+
+    if (next == n_buffered)
     {
         fill_buffer();
         next = 0;
@@ -152,4 +294,11 @@ inline void Buffer<T,U>::input(U& a)
     next++;
 }
 
+template <class T, class U>
+inline void Buffer<T,U>::input_mapped(U& a)
+{
+    // no intermediate buffer, unpack straight from the page cache
+    a.assign(next_mapped(T::size()));
+}
+
 #endif /* TOOLS_BUFFER_H_ */
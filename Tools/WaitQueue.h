@@ -55,6 +55,11 @@ public:
         pthread_cond_signal(&cond);
     }
 
+    void broadcast()
+    {
+        pthread_cond_broadcast(&cond);
+    }
+
     void push(const T& value)
     {
         lock();
@@ -66,7 +71,8 @@ public:
     bool pop(T& value)
     {
         lock();
-        if (running and queue.size() == 0)
+        // there might be several consumers
+        while (running and queue.size() == 0)
             wait();
         if (running)
         {
@@ -77,6 +83,19 @@ public:
         return running;
     }
 
+    bool try_pop(T& value)
+    {
+        lock();
+        bool something_for_you = queue.size() > 0;
+        if (something_for_you)
+        {
+            value = queue.front();
+            queue.pop_front();
+        }
+        unlock();
+        return something_for_you;
+    }
+
     T pop()
     {
         T res;
@@ -103,7 +122,7 @@ public:
     {
         lock();
         running = false;
-        signal();
+        broadcast();
         unlock();
     }
 };
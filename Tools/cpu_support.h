@@ -59,6 +59,15 @@ inline bool cpu_has_pclmul()
 #endif
 }
 
+inline bool cpu_has_vpclmul()
+{
+#ifdef CHECK_VPCLMUL
+    return check_cpu(7, true, 10) and check_cpu(7, false, 16);
+#else
+    return true;
+#endif
+}
+
 inline bool cpu_has_aes()
 {
 #ifdef CHECK_AES
@@ -11,6 +11,8 @@
 #include "octetStream.h"
 #include <arpa/inet.h>
 #include <string.h>
+#include <stdlib.h>
+#include <stdexcept>
 
 #if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
 
@@ -301,3 +303,67 @@ octetStream Hash::final()
     final(res);
     return res;
 }
+
+BroadcastHash::Type BroadcastHash::default_type = BroadcastHash::SHA1;
+
+BroadcastHash::Type BroadcastHash::parse(const char* name)
+{
+    string s = name;
+    if (s == "sha1")
+        return SHA1;
+    else if (s == "blake2b")
+        return BLAKE2B;
+    else
+        throw runtime_error("unknown broadcast hash: " + s);
+}
+
+BroadcastHash::BroadcastHash() :
+        type(default_type), blake2b(0)
+{
+    if (type == BLAKE2B)
+    {
+        void* state;
+        if (posix_memalign(&state, 64, sizeof(crypto_generichash_state)))
+            throw bad_alloc();
+        blake2b = (crypto_generichash_state*) state;
+    }
+    reset();
+}
+
+BroadcastHash::~BroadcastHash()
+{
+    free(blake2b);
+}
+
+void BroadcastHash::reset()
+{
+    size = 0;
+    if (type == SHA1)
+        blk_SHA1_Init(&sha1);
+    else
+        crypto_generichash_init(blake2b, 0, 0, max_length);
+}
+
+void BroadcastHash::update(const void* dataIn, unsigned long len)
+{
+    size += len;
+    if (type == SHA1)
+        blk_SHA1_Update(&sha1, dataIn, len);
+    else
+        crypto_generichash_update(blake2b, (unsigned char*)dataIn, len);
+}
+
+void BroadcastHash::update(const octetStream& os)
+{
+    update(os.get_data(), os.get_length());
+}
+
+void BroadcastHash::final(octetStream& os)
+{
+    unsigned char hashout[max_length];
+    if (type == SHA1)
+        blk_SHA1_Final(hashout, &sha1);
+    else
+        crypto_generichash_final(blake2b, hashout, max_length);
+    os.append(hashout, length());
+}
@@ -49,6 +49,43 @@ public:
 	octetStream final();
 };
 
+/*
+ * Running hash over broadcast data for consistency checks.
+ * SHA-1 is the historical default, BLAKE2b (as in Hash) is considerably
+ * faster on large openings. All parties must use the same type.
+ */
+class BroadcastHash
+{
+public:
+	enum Type { SHA1, BLAKE2B };
+
+	static const int max_length = crypto_generichash_BYTES;
+
+	static Type default_type;
+
+	static Type parse(const char* name);
+
+	BroadcastHash();
+	~BroadcastHash();
+	BroadcastHash(const BroadcastHash&) = delete;
+	BroadcastHash& operator=(const BroadcastHash&) = delete;
+
+	void reset();
+	void update(const void *dataIn, unsigned long len);
+	void update(const octetStream& os);
+	void final(octetStream& os);
+
+	bool empty() const { return size == 0; }
+	int length() const { return type == SHA1 ? HASH_SIZE : max_length; }
+
+private:
+	Type type;
+	unsigned long long size;
+	blk_SHA_CTX sha1;
+	// allocated separately because of its alignment
+	crypto_generichash_state* blake2b;
+};
+
 #define git_SHA_CTX	blk_SHA_CTX
 #define git_SHA1_Init	blk_SHA1_Init
 #define git_SHA1_Update	blk_SHA1_Update
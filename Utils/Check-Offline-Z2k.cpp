@@ -53,6 +53,7 @@ void check_triples_Z2k(int n_players, string type_char = "")
         ss << "-P" << i;
         inputFiles[i].open(ss.str().c_str());
         cout << "Opening file " << ss.str() << endl;
+        BufferBase::skip_file_header(inputFiles[i], ss.str());
     }
 
     int j = 0;
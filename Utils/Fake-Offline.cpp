@@ -49,6 +49,7 @@ void make_bit_triples(const gf2n& key,int N,int ntrip,Dtype dtype,bool zero)
       cout << "Opening " << filename.str() << endl;
       outf[i].open(filename.str().c_str(),ios::out | ios::binary);
       if (outf[i].fail()) { throw file_error(filename.str().c_str()); }
+      write_prep_header<Share<gf2n> >(outf[i], 3 * Share<gf2n>::size());
     }
   for (int i=0; i<ntrip; i++)
     {
@@ -97,6 +98,7 @@ void make_square_tuples(const typename T::mac_key_type& key,int N,int ntrip,cons
       cout << "Opening " << filename.str() << endl;
       outf[i].open(filename.str().c_str(),ios::out | ios::binary);
       if (outf[i].fail()) { throw file_error(filename.str().c_str()); }
+      write_prep_header<T>(outf[i], 2 * T::size());
     }
   for (int i=0; i<ntrip; i++)
     {
@@ -136,6 +138,7 @@ void make_bits(const typename T::mac_key_type& key, int N, int ntrip, bool zero,
       cout << "Opening " << filename.str() << endl;
       outf[i].open(filename.str().c_str(),ios::out | ios::binary);
       if (outf[i].fail()) { throw file_error(filename.str().c_str()); }
+      write_prep_header<T>(outf[i], T::size());
     }
   for (int i=0; i<ntrip; i++)
     { if ((G.get_uchar()&1)==0 || zero) { a.assign_zero(); }
@@ -174,6 +177,10 @@ void make_inputs(const typename T::mac_key_type& key,int N,int ntrip,const strin
           cout << "Opening " << filename.str() << endl;
           outf[i].open(filename.str().c_str(),ios::out | ios::binary);
           if (outf[i].fail()) { throw file_error(filename.str().c_str()); }
+          if (i == player)
+            write_prep_header<InputTuple<T> >(outf[i], InputTuple<T>::size());
+          else
+            write_prep_header<T>(outf[i], T::size());
         }
       for (int i=0; i<ntrip; i++)
         {
@@ -198,7 +205,7 @@ void make_PreMulC(const typename T::mac_key_type& key, int N, int ntrip, bool ze
 {
   stringstream ss;
   ss << prep_data_prefix << "PreMulC-" << T::type_short();
-  Files<T> files(N, key, ss.str());
+  Files<T> files(N, key, ss.str(), 3);
   PRNG G;
   G.ReSeed();
   typename T::clear a, b, c;
@@ -221,6 +228,44 @@ void make_PreMulC(const typename T::mac_key_type& key, int N, int ntrip, bool ze
     }
 }
 
+/* N      = Number players
+ * ntrip  = Number matrix triples needed
+ * dims   = (rows, inner, columns) of the product
+ */
+template<class T>
+void make_matrix_triples(const typename T::mac_key_type& key, int N, int ntrip,
+    const array<int, 3>& dims, bool zero)
+{
+  int n_rows = dims[0], n_inner = dims[1], n_cols = dims[2];
+  Files<T> files(N, key,
+      prep_data_prefix + DataPositions::matrix_name(dims) + "-"
+          + T::type_short(),
+      n_rows * n_inner + n_inner * n_cols + n_rows * n_cols);
+  vector<typename T::clear> a(n_rows * n_inner), b(n_inner * n_cols);
+  for (int t = 0; t < ntrip; t++)
+    {
+      if (!zero)
+        {
+          for (auto& x : a)
+            x.randomize(files.G);
+          for (auto& x : b)
+            x.randomize(files.G);
+        }
+      for (auto& x : a)
+        files.output_shares(x);
+      for (auto& x : b)
+        files.output_shares(x);
+      for (int i = 0; i < n_rows; i++)
+        for (int j = 0; j < n_cols; j++)
+          {
+            typename T::clear c;
+            for (int k = 0; k < n_inner; k++)
+              c += a[i * n_inner + k] * b[k * n_cols + j];
+            files.output_shares(c);
+          }
+    }
+}
+
 template<class T>
 void make_basic(const typename T::mac_key_type& key, int nplayers, int nitems, bool zero)
 {
@@ -245,8 +290,10 @@ int main(int argc, const char** argv)
 
   ez::ezOptionParser opt;
 
-  opt.syntax = "./Fake-Offline.x <nplayers> [OPTIONS]\n\nOptions with 2 arguments take the form '-X <#gf2n tuples>,<#modp tuples>'";
-  opt.example = "./Fake-Offline.x 2 -lgp 128 -lg2 128 --default 10000\n./Fake-Offline.x 3 -trip 50000,10000 -btrip 100000\n";
+  opt.syntax = "./Fake-Offline.x <nplayers> [OPTIONS]\n\nOptions with 2 arguments take the form '-X <#gf2n tuples>,<#modp tuples>'\n"
+      "Matrix triples take the form '-m <rows>,<inner>,<columns>'";
+  opt.example = "./Fake-Offline.x 2 -lgp 128 -lg2 128 --default 10000\n./Fake-Offline.x 3 -trip 50000,10000 -btrip 100000\n"
+      "./Fake-Offline.x 2 -m 10,20,10 -m 1,20,10 -nm 100\n";
 
   opt.add(
         "128", // Default.
@@ -347,6 +394,24 @@ int main(int argc, const char** argv)
         "-z", // Flag token.
         "--zero" // Flag token.
   );
+  opt.add(
+        "", // Default.
+        0, // Required?
+        3, // Number of args expected.
+        ',', // Delimiter if expecting multiple args.
+        "Dimensions of matrix triples, can be given several times", // Help description.
+        "-m", // Flag token.
+        "--matrix" // Flag token.
+  );
+  opt.add(
+        "", // Default.
+        0, // Required?
+        1, // Number of args expected.
+        0, // Delimiter if expecting multiple args.
+        "Number of matrix triples per dimensions", // Help description.
+        "-nm", // Flag token.
+        "--nmatrices" // Flag token.
+  );
   opt.add(
         "", // Default.
         0, // Required?
@@ -471,6 +536,18 @@ int generate(ez::ezOptionParser& opt)
   if (opt.isSet("--nbitgf2ntriples"))
     opt.get("--nbitgf2ntriples")->getInt(nbitgf2ntrip);
 
+  vector<array<int, 3>> matrix_dims;
+  int nmatrices = default_num;
+  if (opt.isSet("--matrix"))
+  {
+    vector<vector<int>> all_dims;
+    opt.get("--matrix")->getMultiInts(all_dims);
+    for (auto& dims : all_dims)
+      matrix_dims.push_back({{dims.at(0), dims.at(1), dims.at(2)}});
+  }
+  if (opt.isSet("--nmatrices"))
+    opt.get("--nmatrices")->getInt(nmatrices);
+
   bool zero = opt.isSet("--zero");
   if (zero)
       cout << "Set all values to zero" << endl;
@@ -517,6 +594,11 @@ int generate(ez::ezOptionParser& opt)
   make_PreMulC<sgf2n>(key2,nplayers,ninv,zero);
   if (T::clear::invertible)
     make_PreMulC<T>(keyp,nplayers,ninv,zero);
+  for (auto& dims : matrix_dims)
+    {
+      make_matrix_triples<sgf2n>(key2,nplayers,nmatrices,dims,zero);
+      make_matrix_triples<T>(keyp,nplayers,nmatrices,dims,zero);
+    }
 
   // replicated secret sharing only for three parties
   if (nplayers == 3)
@@ -533,6 +615,11 @@ int generate(ez::ezOptionParser& opt)
 
   make_basic<SemiShare<gfp>>({}, nplayers, default_num, zero);
   make_basic<SemiShare<gf2n>>({}, nplayers, default_num, zero);
+  for (auto& dims : matrix_dims)
+    {
+      make_matrix_triples<SemiShare<gfp>>({}, nplayers, nmatrices, dims, zero);
+      make_matrix_triples<SemiShare<gf2n>>({}, nplayers, nmatrices, dims, zero);
+    }
 
   make_mult_triples<GC::SemiSecret>({}, nplayers, default_num, zero, prep_data_prefix);
   make_bits<GC::SemiSecret>({}, nplayers, default_num, zero);
@@ -0,0 +1,49 @@
+/*
+ * broadcast-hash-bench.cpp
+ *
+ * Throughput of the hashes for broadcast consistency checks
+ */
+
+#include "Tools/sha1.h"
+#include "Tools/octetStream.h"
+#include "Tools/time-func.h"
+
+#include <iostream>
+#include <stdlib.h>
+using namespace std;
+
+void bench(const char* name, const octetStream& message, int n_messages)
+{
+    BroadcastHash::default_type = BroadcastHash::parse(name);
+    BroadcastHash hash;
+    octetStream result;
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < n_messages; i++)
+        hash.update(message);
+    hash.final(result);
+    timer.stop();
+    double n_bytes = double(message.get_length()) * n_messages;
+    cout << name << ": " << n_bytes / timer.elapsed() / 1e6 << " MB/s for "
+            << n_messages << " messages of " << message.get_length()
+            << " bytes" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    // total amount and size of a single broadcast message
+    size_t total = 1 << 30, message_size = 1 << 16;
+    if (argc > 1)
+        message_size = atoi(argv[1]);
+    if (argc > 2)
+        total = atoll(argv[2]);
+    if (message_size < 1)
+        message_size = 1;
+
+    octetStream message;
+    message.append_random(message_size);
+    int n_messages = total / message_size;
+
+    bench("sha1", message, n_messages);
+    bench("blake2b", message, n_messages);
+}
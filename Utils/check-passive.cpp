@@ -2,6 +2,7 @@
 #include "Math/gfp.h"
 #include "Math/Z2k.h"
 #include "Math/Setup.h"
+#include "Tools/Buffer.h"
 
 #include <fstream>
 #include <vector>
@@ -24,6 +25,7 @@ void check_triples(int n_players, string type_char = "")
         ss << "-P" << i;
         inputFiles[i].open(ss.str().c_str());
         cout << "Opening file " << ss.str() << endl;
+        BufferBase::skip_file_header(inputFiles[i], ss.str());
     }
 
     int j = 0;
@@ -85,6 +87,7 @@ void check_triples_Z2k(int n_players, string type_char = "", bool macs = true)
         ss << "-P" << i;
         inputFiles[i].open(ss.str().c_str());
         cout << "Opening file " << ss.str() << endl;
+        BufferBase::skip_file_header(inputFiles[i], ss.str());
     }
 
     int j = 0;
@@ -9,14 +9,12 @@
 #include "YaoGarbleWire.h"
 #include "Tools/Worker.h"
 
-class YaoGate;
-
 class YaoAndJob
 {
 	GC::Memory< GC::Secret<YaoGarbleWire> >* S;
 	const vector<int>* args;
 	size_t start, end, n_gates;
-	YaoGate* gate;
+	void* gate;
 	long counter;
 	PRNG prng;
 	map<string, Timer> timers;
@@ -43,7 +41,7 @@ public:
 
 	void dispatch(GC::Memory<GC::Secret<YaoGarbleWire> >& S, const vector<int>& args,
 			size_t start, size_t end, size_t n_gates,
-			YaoGate* gate, long counter, bool repeat)
+			void* gate, long counter, bool repeat)
 	{
 		this->S = &S;
 		this->args = &args;
@@ -20,9 +20,10 @@ public:
     static const int MORE = -2;
 
     long counter;
+    bool half_gates;
 
     YaoCommon() :
-        log_n_threads(8), counter(0)
+        log_n_threads(8), counter(0), half_gates(false)
     {
     }
 
@@ -15,8 +15,10 @@
 #include "GC/ThreadMaster.hpp"
 #include "Processor/Instruction.hpp"
 
-YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts) :
-        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous)
+YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts,
+        bool half_gates) :
+        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous),
+        half_gates(half_gates)
 {
 }
 
@@ -14,8 +14,9 @@ class YaoEvalMaster : public GC::ThreadMaster<GC::Secret<YaoEvalWire>>
 {
 public:
     bool continuous;
+    bool half_gates;
 
-    YaoEvalMaster(bool continuous, OnlineOptions& opts);
+    YaoEvalMaster(bool continuous, OnlineOptions& opts, bool half_gates = false);
 
     GC::Thread<GC::Secret<YaoEvalWire>>* new_thread(int i);
 };
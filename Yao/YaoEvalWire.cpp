@@ -6,6 +6,7 @@
 #include "config.h"
 #include "YaoEvalWire.h"
 #include "YaoGate.h"
+#include "YaoHalfGate.h"
 #include "YaoEvaluator.h"
 #include "BMR/prf.h"
 #include "BMR/common.h"
@@ -31,6 +32,16 @@ void YaoEvalWire::public_input(bool value)
 template<bool repeat>
 void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 		const vector<int>& args)
+{
+	if (YaoEvaluator::s().half_gates)
+		and_gates<repeat, YaoHalfGate>(processor, args);
+	else
+		and_gates<repeat, YaoGate>(processor, args);
+}
+
+template<bool repeat, class T>
+void YaoEvalWire::and_gates(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
+		const vector<int>& args)
 {
 	int total_ands = processor.check_args(args, 4);
 	if (total_ands < 10)
@@ -39,9 +50,9 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 	Key* labels;
 	Key* hashes;
 	vector<Key> label_vec, hash_vec;
-	size_t n_hashes = total_ands;
+	size_t n_hashes = T::N_EVAL_HASHES * total_ands;
 	Key label_arr[1000], hash_arr[1000];
-	if (total_ands < 1000)
+	if (n_hashes < 1000)
 	{
 		labels = label_arr;
 		hashes = hash_arr;
@@ -66,8 +77,9 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 			auto& left_wire = left.get_reg(k);
 			auto& right_key = right.get_reg(repeat ? 0 : k).key;
 			evaluator.counter++;
-			labels[i_label++] = YaoGate::E_input(left_wire.key, right_key,
+			T::eval_inputs(&labels[i_label], left_wire.key, right_key,
 					evaluator.get_gate_id());
+			i_label += T::N_EVAL_HASHES;
 		}
 	}
 	MMO& mmo = evaluator.mmo;
@@ -89,10 +101,10 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 		{
 			auto& right_wire = right.get_reg(repeat ? 0 : k);
 			auto& left_wire = left.get_reg(k);
-			YaoGate gate;
+			T gate;
 			evaluator.load_gate(gate);
-			gate.eval(out.get_reg(k), hashes[j++],
-					gate.get_entry(left_wire.external, right_wire.external));
+			gate.eval(out.get_reg(k), &hashes[j], left_wire, right_wire);
+			j += T::N_EVAL_HASHES;
 		}
 	}
 }
@@ -155,6 +167,15 @@ void YaoEvalWire::op(const YaoEvalWire& left, const YaoEvalWire& right,
 		Function func)
 {
     (void)func;
+	auto& evaluator = YaoEvaluator::s();
+	if (evaluator.half_gates)
+	{
+		YaoHalfGate gate;
+		evaluator.load_gate(gate);
+		evaluator.counter++;
+		gate.eval(*this, left, right);
+		return;
+	}
 	YaoGate gate;
 	YaoEvaluator::s().load_gate(gate);
 	YaoEvaluator::s().counter++;
@@ -37,6 +37,9 @@ public:
 	template<bool repeat>
 	static void and_(GC::Processor<GC::Secret<YaoEvalWire>>& processor,
 			const vector<int>& args);
+	template<bool repeat, class T>
+	static void and_gates(GC::Processor<GC::Secret<YaoEvalWire>>& processor,
+			const vector<int>& args);
 
 	static void inputb(GC::Processor<GC::Secret<YaoEvalWire>>& processor,
 			const vector<int>& args);
@@ -22,6 +22,7 @@ YaoEvaluator::YaoEvaluator(int thread_num, YaoEvalMaster& master) :
 		ot_ext(OTExtensionWithMatrix::setup(player, {}, RECEIVER, true))
 {
 	set_n_program_threads(master.machine.nthreads);
+	half_gates = master.half_gates;
 }
 
 void YaoEvaluator::pre_run()
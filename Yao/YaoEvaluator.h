@@ -46,12 +46,14 @@ public:
 	bool receive(Player& P);
 	void receive_to_store(Player& P);
 
-	void load_gate(YaoGate& gate);
+	template<class T>
+	void load_gate(T& gate);
 
 	long get_gate_id() { return gate_id(thread_num); }
 };
 
-inline void YaoEvaluator::load_gate(YaoGate& gate)
+template<class T>
+inline void YaoEvaluator::load_gate(T& gate)
 {
 	gates.unserialize(gate);
 }
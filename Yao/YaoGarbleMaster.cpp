@@ -15,8 +15,10 @@
 #include "GC/ThreadMaster.hpp"
 #include "Processor/Instruction.hpp"
 
-YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold) :
-        super(opts), continuous(continuous), threshold(threshold)
+YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts,
+        int threshold, bool half_gates) :
+        super(opts), continuous(continuous), threshold(threshold),
+        half_gates(half_gates)
 {
     PRNG G;
     G.ReSeed();
@@ -18,9 +18,11 @@ class YaoGarbleMaster : public GC::ThreadMaster<GC::Secret<YaoGarbleWire>>
 public:
     bool continuous;
     int threshold;
+    bool half_gates;
     Key delta;
 
-    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024);
+    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024,
+            bool half_gates = false);
 
     GC::Thread<GC::Secret<YaoGarbleWire>>* new_thread(int i);
 };
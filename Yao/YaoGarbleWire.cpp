@@ -5,6 +5,7 @@
 
 #include "YaoGarbleWire.h"
 #include "YaoGate.h"
+#include "YaoHalfGate.h"
 #include "YaoGarbler.h"
 #include "GC/ArgTuples.h"
 
@@ -66,7 +67,8 @@ void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& p
 	party.and_prepare_timer.start();
 	processor.complexity += total;
 	SendBuffer& gates = party.gates;
-	gates.allocate(total * sizeof(YaoGate));
+	size_t gate_size = party.get_gate_size();
+	gates.allocate(total * gate_size);
 	int max_gates_per_thread = max(party.get_threshold() / 2,
 			(total + party.get_n_worker_threads() - 1) / party.get_n_worker_threads());
 	int i_thread = 0, i_gate = 0, start = 0;
@@ -76,8 +78,8 @@ void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& p
 		size_t end = j + 4;
 		if (i_gate >= max_gates_per_thread or end >= args.size())
 		{
-			YaoGate* gate = (YaoGate*)gates.end();
-			gates.skip(i_gate * sizeof(YaoGate));
+			void* gate = gates.end();
+			gates.skip(i_gate * gate_size);
 			party.timers["Dispatch"].start();
 			party.and_jobs[i_thread++]->dispatch(processor.S, args, start, end,
 					i_gate, gate, party.get_gate_id(), repeat);
@@ -104,25 +106,44 @@ void YaoGarbleWire::and_singlethread(GC::Processor<GC::Secret<YaoGarbleWire> >&
 	size_t n_args = args.size();
 	auto& garbler = YaoGarbler::s();
 	SendBuffer& gates = garbler.gates;
-	YaoGate* gate = (YaoGate*)gates.allocate_and_skip(total_ands * sizeof(YaoGate));
+	void* gate = gates.allocate_and_skip(total_ands * garbler.get_gate_size());
 	long counter = garbler.get_gate_id();
 	and_(processor.S, args, 0, n_args, total_ands, gate, counter,
 			garbler.prng, garbler.timers, repeat, garbler);
 	garbler.counter += counter - garbler.get_gate_id();
 }
 
+size_t YaoGarbler::get_gate_size()
+{
+	return half_gates ? sizeof(YaoHalfGate) : sizeof(YaoGate);
+}
+
 void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
 		const vector<int>& args, size_t start, size_t end, size_t total_ands,
-		YaoGate* gate, long& counter, PRNG& prng, map<string, Timer>& timers,
+		void* gate, long& counter, PRNG& prng, map<string, Timer>& timers,
+		bool repeat, YaoGarbler& garbler)
+{
+	if (garbler.half_gates)
+		and_(S, args, start, end, total_ands, (YaoHalfGate*) gate, counter,
+				prng, timers, repeat, garbler);
+	else
+		and_(S, args, start, end, total_ands, (YaoGate*) gate, counter,
+				prng, timers, repeat, garbler);
+}
+
+template<class T>
+void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
+		const vector<int>& args, size_t start, size_t end, size_t total_ands,
+		T* gate, long& counter, PRNG& prng, map<string, Timer>& timers,
 		bool repeat, YaoGarbler& garbler)
 {
 	(void)timers;
 	Key* labels;
 	Key* hashes;
 	vector<Key> label_vec, hash_vec;
-	size_t n_hashes = 4 * total_ands;
+	size_t n_hashes = T::N_GARBLE_HASHES * total_ands;
 	Key label_arr[400], hash_arr[400];
-	if (total_ands < 100)
+	if (n_hashes <= 400)
 	{
 		labels = label_arr;
 		hashes = hash_arr;
@@ -144,11 +165,9 @@ void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
 			auto& left_wire = S[args[i + 2]].get_reg(k);
 			const Key& right_key = S[args[i + 3]].get_reg(repeat ? 0 : k).key;
 			counter++;
-			for (int i = 0; i < 2; i++)
-				for (int j = 0; j < 2; j++)
-					labels[i_label++] = YaoGate::E_input(
-							left_wire.key ^ (i ? delta : 0),
-							right_key ^ (j ? delta : 0), counter);
+			T::garble_inputs(&labels[i_label], left_wire.key, right_key,
+					delta, counter);
+			i_label += T::N_GARBLE_HASHES;
 		}
 	}
 	//timers["Hash input"].stop();
@@ -177,14 +196,11 @@ void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
 			//timers["Inner ref"].start();
 			auto& left_wire = S[args[i + 2]].get_reg(k);
 			//timers["Inner ref"].stop();
-			//timers["Randomizing"].start();
-			out.get_reg(k).randomize(prng);
-			//timers["Randomizing"].stop();
 			//timers["Gate computation"].start();
-			(gate++)->garble(out.get_reg(k), &hashes[i_hash], left_wire.mask,
-					right_wire.mask, 0x0001, garbler.get_delta());
+			(gate++)->garble(out.get_reg(k), &hashes[i_hash], left_wire,
+					right_wire, delta, prng);
 			//timers["Gate computation"].stop();
-			i_hash += 4;
+			i_hash += T::N_GARBLE_HASHES;
 		}
 	}
 	//timers["Garbling"].stop();
@@ -235,7 +251,8 @@ void YaoGarbleWire::inputb(GC::Processor<GC::Secret<YaoGarbleWire>>& processor,
 	}
 }
 
-inline void YaoGarbler::store_gate(const YaoGate& gate)
+template<class T>
+inline void YaoGarbler::store_gate(const T& gate)
 {
 	gates.serialize(gate);
 }
@@ -244,6 +261,13 @@ void YaoGarbleWire::op(const YaoGarbleWire& left, const YaoGarbleWire& right,
 		Function func)
 {
 	auto& garbler = YaoGarbler::s();
+	if (garbler.half_gates)
+	{
+		garbler.counter++;
+		YaoHalfGate gate(*this, left, right, func);
+		garbler.store_gate(gate);
+		return;
+	}
 	randomize(garbler.prng);
 	YaoGarbler::s().counter++;
 	YaoGate gate(*this, left, right, func);
@@ -12,6 +12,7 @@
 #include <map>
 
 class YaoGate;
+class YaoHalfGate;
 class YaoGarbler;
 
 class YaoGarbleWire : public Phase
@@ -45,7 +46,12 @@ public:
 			const vector<int>& args, bool repeat);
 	static void and_(GC::Memory<GC::Secret<YaoGarbleWire>>& S,
 			const vector<int>& args, size_t start, size_t end,
-			size_t total_ands, YaoGate* gate, long& counter, PRNG& prng,
+			size_t total_ands, void* gate, long& counter, PRNG& prng,
+			map<string, Timer>& timers, bool repeat, YaoGarbler& garbler);
+	template<class T>
+	static void and_(GC::Memory<GC::Secret<YaoGarbleWire>>& S,
+			const vector<int>& args, size_t start, size_t end,
+			size_t total_ands, T* gate, long& counter, PRNG& prng,
 			map<string, Timer>& timers, bool repeat, YaoGarbler& garbler);
 
 	static void inputb(GC::Processor<GC::Secret<YaoGarbleWire>>& processor,
@@ -27,6 +27,7 @@ YaoGarbler::YaoGarbler(int thread_num, YaoGarbleMaster& master) :
 {
 	prng.ReSeed();
 	set_n_program_threads(master.machine.nthreads);
+	half_gates = master.half_gates;
 
 	and_jobs.resize(get_n_worker_threads());
 	for (auto& job : and_jobs)
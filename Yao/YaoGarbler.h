@@ -66,13 +66,15 @@ public:
 	void process_receiver_inputs();
 
 	const Key& get_delta() { return master.delta; }
-	void store_gate(const YaoGate& gate);
+	template<class T>
+	void store_gate(const T& gate);
 
 	int get_n_worker_threads()
 	{ return max(1u, thread::hardware_concurrency() / master.machine.nthreads); }
 	int get_threshold() { return master.threshold; }
 
 	long get_gate_id() { return gate_id(thread_num); }
+	size_t get_gate_size();
 };
 
 inline YaoGarbler& YaoGarbler::s()
@@ -15,13 +15,26 @@ class YaoGate
 {
 	Key entries[2][2];
 public:
+	static const int N_GARBLE_HASHES = 4;
+	static const int N_EVAL_HASHES = 1;
+
 	static Key E_input(const Key& left, const Key& right, long T);
 
+	static void garble_inputs(Key* inputs, const Key& left, const Key& right,
+			const Key& delta, long T);
+	static void eval_inputs(Key* inputs, const Key& left, const Key& right,
+			long T);
+
 	YaoGate() {}
 	YaoGate(const YaoGarbleWire& out, const YaoGarbleWire& left,
 			const YaoGarbleWire& right, Function func);
 	void garble(const YaoGarbleWire& out, const Key* hashes, bool left_mask,
 			bool right_mask, Function func, Key delta);
+	void garble(YaoGarbleWire& out, const Key* hashes,
+			const YaoGarbleWire& left, const YaoGarbleWire& right,
+			const Key& delta, PRNG& prng);
+	void eval(YaoEvalWire& out, const Key* hashes, const YaoEvalWire& left,
+			const YaoEvalWire& right);
 	void eval(YaoEvalWire& out, const YaoEvalWire& left, const YaoEvalWire& right);
 	void eval(YaoEvalWire& out, const Key& hash,
 			const Key& entry);
@@ -38,6 +51,21 @@ inline Key YaoGate::E_input(const Key& left, const Key& right, long T)
 	return res;
 }
 
+inline void YaoGate::garble_inputs(Key* inputs, const Key& left,
+		const Key& right, const Key& delta, long T)
+{
+	for (int i = 0; i < 2; i++)
+		for (int j = 0; j < 2; j++)
+			inputs[2 * i + j] = E_input(left ^ (i ? delta : 0),
+					right ^ (j ? delta : 0), T);
+}
+
+inline void YaoGate::eval_inputs(Key* inputs, const Key& left,
+		const Key& right, long T)
+{
+	inputs[0] = E_input(left, right, T);
+}
+
 inline void YaoGate::garble(const YaoGarbleWire& out, const Key* hashes,
 		bool left_mask, bool right_mask, Function func, Key delta)
 {
@@ -64,6 +92,20 @@ inline void YaoGate::garble(const YaoGarbleWire& out, const Key* hashes,
 #endif
 }
 
+inline void YaoGate::garble(YaoGarbleWire& out, const Key* hashes,
+		const YaoGarbleWire& left, const YaoGarbleWire& right,
+		const Key& delta, PRNG& prng)
+{
+	out.randomize(prng);
+	garble(out, hashes, left.mask, right.mask, 0x0001, delta);
+}
+
+inline void YaoGate::eval(YaoEvalWire& out, const Key* hashes,
+		const YaoEvalWire& left, const YaoEvalWire& right)
+{
+	eval(out, hashes[0], get_entry(left.external, right.external));
+}
+
 inline void YaoGate::eval(YaoEvalWire& out, const Key& hash, const Key& entry)
 {
 	Key key = entry;
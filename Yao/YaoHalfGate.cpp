@@ -0,0 +1,32 @@
+/*
+ * YaoHalfGate.cpp
+ *
+ */
+
+#include "YaoHalfGate.h"
+#include "YaoGarbler.h"
+#include "YaoEvaluator.h"
+#include "Tools/MMO.h"
+
+YaoHalfGate::YaoHalfGate(YaoGarbleWire& out, const YaoGarbleWire& left,
+		const YaoGarbleWire& right, Function func)
+{
+	// only used for AND because XOR is free
+	(void) func;
+	auto& garbler = YaoGarbler::s();
+	Key inputs[N_GARBLE_HASHES], hashes[N_GARBLE_HASHES];
+	garble_inputs(inputs, left.key, right.key, garbler.get_delta(),
+			garbler.get_gate_id());
+	garbler.mmo.hash<N_GARBLE_HASHES>(hashes, inputs);
+	garble(out, hashes, left, right, garbler.get_delta(), garbler.prng);
+}
+
+void YaoHalfGate::eval(YaoEvalWire& out, const YaoEvalWire& left,
+		const YaoEvalWire& right)
+{
+	auto& evaluator = YaoEvaluator::s();
+	Key inputs[N_EVAL_HASHES], hashes[N_EVAL_HASHES];
+	eval_inputs(inputs, left.key, right.key, evaluator.get_gate_id());
+	evaluator.mmo.hash<N_EVAL_HASHES>(hashes, inputs);
+	eval(out, hashes, left, right);
+}
@@ -0,0 +1,109 @@
+/*
+ * YaoHalfGate.h
+ *
+ */
+
+#ifndef YAO_YAOHALFGATE_H_
+#define YAO_YAOHALFGATE_H_
+
+#include "config.h"
+#include "BMR/Key.h"
+#include "YaoGarbleWire.h"
+#include "YaoEvalWire.h"
+
+/*
+ * AND gate garbled with half-gates (Zahur, Rosulek, Evans):
+ * two ciphertexts per gate instead of four, compatible with free XOR.
+ * The hash is fixed-key AES (MMO) with the gate number and
+ * the half as tweak.
+ */
+class YaoHalfGate
+{
+	// generator half and evaluator half
+	Key entries[2];
+
+public:
+	static const int N_GARBLE_HASHES = 4;
+	static const int N_EVAL_HASHES = 2;
+
+	static Key H_input(const Key& label, long T, int half);
+
+	static void garble_inputs(Key* inputs, const Key& left, const Key& right,
+			const Key& delta, long T);
+	static void eval_inputs(Key* inputs, const Key& left, const Key& right,
+			long T);
+
+	YaoHalfGate() {}
+	YaoHalfGate(YaoGarbleWire& out, const YaoGarbleWire& left,
+			const YaoGarbleWire& right, Function func);
+	void garble(YaoGarbleWire& out, const Key* hashes,
+			const YaoGarbleWire& left, const YaoGarbleWire& right,
+			const Key& delta, PRNG& prng);
+	void eval(YaoEvalWire& out, const YaoEvalWire& left, const YaoEvalWire& right);
+	void eval(YaoEvalWire& out, const Key* hashes, const YaoEvalWire& left,
+			const YaoEvalWire& right);
+};
+
+inline Key YaoHalfGate::H_input(const Key& label, long T, int half)
+{
+	return label.doubling(1) ^ Key(half, T);
+}
+
+inline void YaoHalfGate::garble_inputs(Key* inputs, const Key& left,
+		const Key& right, const Key& delta, long T)
+{
+	// indexed by the signal bit of the label
+	inputs[0] = H_input(left, T, 0);
+	inputs[1] = H_input(left ^ delta, T, 0);
+	inputs[2] = H_input(right, T, 1);
+	inputs[3] = H_input(right ^ delta, T, 1);
+}
+
+inline void YaoHalfGate::eval_inputs(Key* inputs, const Key& left,
+		const Key& right, long T)
+{
+	inputs[0] = H_input(left, T, 0);
+	inputs[1] = H_input(right, T, 1);
+}
+
+inline void YaoHalfGate::garble(YaoGarbleWire& out, const Key* hashes,
+		const YaoGarbleWire& left, const YaoGarbleWire& right,
+		const Key& delta, PRNG& prng)
+{
+	(void) prng;
+	// the label for zero has the mask as signal bit
+	bool left_mask = left.mask, right_mask = right.mask;
+	Key left_zero = left.key ^ (left_mask ? delta : 0);
+
+	// generator half
+	entries[0] = hashes[0] ^ hashes[1] ^ (right_mask ? delta : 0);
+	Key generator = hashes[left_mask] ^ (left_mask ? entries[0] : 0);
+
+	// evaluator half
+	entries[1] = hashes[2] ^ hashes[3] ^ left_zero;
+	Key evaluator = hashes[2 + right_mask]
+			^ (right_mask ? entries[1] ^ left_zero : 0);
+
+	Key out_zero = generator ^ evaluator;
+	bool out_mask = out_zero.get_signal();
+	out.set(out_zero ^ (out_mask ? delta : 0), out_mask);
+#ifdef DEBUG
+	cout << "half gates " << entries[0] << " " << entries[1] << endl;
+	cout << "out " << out.mask << " " << out.key << " " << (out.key ^ delta) << endl;
+#endif
+}
+
+inline void YaoHalfGate::eval(YaoEvalWire& out, const Key* hashes,
+		const YaoEvalWire& left, const YaoEvalWire& right)
+{
+	Key generator = hashes[0] ^ (left.external ? entries[0] : 0);
+	Key evaluator = hashes[1]
+			^ (right.external ? entries[1] ^ left.key : 0);
+	out.set(generator ^ evaluator);
+#ifdef DEBUG
+	cout << "external " << left.external << " " << right.external << endl;
+	cout << "out " << out.key << endl;
+#endif
+}
+
+#endif /* YAO_YAOHALFGATE_H_ */
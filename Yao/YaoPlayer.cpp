@@ -58,6 +58,16 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 			"-t", // Flag token.
 			"--threshold" // Flag token.
 	);
+	opt.add(
+			"", // Default.
+			0, // Required?
+			0, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			"Half-gates garbling with two ciphertexts per AND gate "
+			"(has to be used by both parties).", // Help description.
+			"-hg", // Flag token.
+			"--half-gates" // Flag token.
+	);
 	OnlineOptions online_opts(opt, argc, argv);
 	opt.parse(argc, argv);
 	opt.syntax = "./yao-player.x [OPTIONS] <progname>";
@@ -82,12 +92,14 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 	opt.get("-h")->getString(hostname);
 	bool continuous = not opt.get("-O")->isSet;
 	opt.get("-t")->getInt(threshold);
+	bool half_gates = opt.get("-hg")->isSet;
 
 	GC::ThreadMasterBase* master;
 	if (my_num == 0)
-	    master = new YaoGarbleMaster(continuous, online_opts, threshold);
+	    master = new YaoGarbleMaster(continuous, online_opts, threshold,
+	            half_gates);
 	else
-	    master = new YaoEvalMaster(continuous, online_opts);
+	    master = new YaoEvalMaster(continuous, online_opts, half_gates);
 
 	server = Server::start_networking(master->N, my_num, 2, hostname, pnb);
 	master->run(progname);